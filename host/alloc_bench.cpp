@@ -0,0 +1,259 @@
+// Host-side allocation trace replay benchmark for TlsfHeap
+//
+// Replays allocation traces against the firmware heap and against the old
+// bump allocator and reports throughput and fragmentation.
+//
+// Usage: alloc_bench [trace-file...]
+//   With no arguments a set of built-in synthetic traces is replayed.
+//   Trace files hold one operation per line:
+//     a <id> <size>   allocate <size> bytes and remember it as <id>
+//     f <id>          free the allocation remembered as <id>
+
+#include "tlsf_heap.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t HEAP_BYTES = 64u << 20;  // Same as the DTCM heap on target
+
+struct TraceOp {
+    bool is_alloc;
+    uint32_t id;
+    uint32_t size;
+};
+
+struct Trace {
+    std::string name;
+    std::vector<TraceOp> ops;
+    uint32_t max_id;
+};
+
+// Small deterministic generator so every run replays identical traces
+struct Lcg {
+    uint32_t state;
+    explicit Lcg(uint32_t seed) : state(seed) {}
+    uint32_t next() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+    uint32_t range(uint32_t lo, uint32_t hi) { return lo + next() % (hi - lo + 1); }
+};
+
+// SimpleMap/SimpleList node churn: small fixed sizes, random erase order
+Trace make_container_churn() {
+    Trace t{"container_churn", {}, 0};
+    Lcg rng(1);
+    std::vector<uint32_t> live;
+    uint32_t id = 0;
+    for (int i = 0; i < 400000; ++i) {
+        if (live.size() < 2000 || (rng.next() & 1)) {
+            uint32_t size = (rng.next() & 1) ? 12 : 16;
+            t.ops.push_back({true, id, size});
+            live.push_back(id++);
+        } else {
+            size_t pick = rng.next() % live.size();
+            t.ops.push_back({false, live[pick], 0});
+            live[pick] = live.back();
+            live.pop_back();
+        }
+    }
+    for (uint32_t l : live) t.ops.push_back({false, l, 0});
+    t.max_id = id;
+    return t;
+}
+
+// Mixed sizes with a long-lived tail, the classic fragmentation stressor
+Trace make_mixed_sizes() {
+    Trace t{"mixed_sizes", {}, 0};
+    Lcg rng(2);
+    std::vector<uint32_t> live;
+    uint32_t id = 0;
+    for (int i = 0; i < 200000; ++i) {
+        if (live.size() < 500 || rng.range(0, 99) < 55) {
+            uint32_t size = rng.range(0, 9) < 8 ? rng.range(8, 256) : rng.range(257, 8192);
+            t.ops.push_back({true, id, size});
+            live.push_back(id++);
+        } else {
+            size_t pick = rng.next() % live.size();
+            t.ops.push_back({false, live[pick], 0});
+            live[pick] = live.back();
+            live.pop_back();
+        }
+    }
+    for (uint32_t l : live) t.ops.push_back({false, l, 0});
+    t.max_id = id;
+    return t;
+}
+
+// DataProcessor::process_array_data: arrays that keep growing and are
+// replaced, interleaved with small temporaries
+Trace make_growing_arrays() {
+    Trace t{"growing_arrays", {}, 0};
+    uint32_t id = 0;
+    for (int round = 0; round < 2000; ++round) {
+        uint32_t array_id = id++;
+        t.ops.push_back({true, array_id, 40});
+        for (uint32_t size = 80; size <= 4096; size *= 2) {
+            uint32_t temp = id++;
+            t.ops.push_back({true, temp, 12});
+            uint32_t grown = id++;
+            t.ops.push_back({true, grown, size});
+            t.ops.push_back({false, array_id, 0});
+            t.ops.push_back({false, temp, 0});
+            array_id = grown;
+        }
+        t.ops.push_back({false, array_id, 0});
+    }
+    t.max_id = id;
+    return t;
+}
+
+bool load_trace(const char* path, Trace& t) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "alloc_bench: cannot open %s\n", path);
+        return false;
+    }
+    t.name = path;
+    t.max_id = 0;
+    char op;
+    unsigned id, size;
+    while (fscanf(f, " %c %u", &op, &id) == 2) {
+        if (op == 'a') {
+            if (fscanf(f, " %u", &size) != 1) break;
+            t.ops.push_back({true, id, size});
+        } else {
+            t.ops.push_back({false, id, 0});
+        }
+        if (id + 1 > t.max_id) t.max_id = id + 1;
+    }
+    fclose(f);
+    return true;
+}
+
+struct Result {
+    double ns_per_op;
+    size_t peak_live;
+    size_t footprint;
+    uint32_t failed;
+};
+
+Result replay_tlsf(const Trace& t, std::vector<uint8_t>& arena) {
+    static TlsfHeap heap;
+    std::vector<void*> ptrs(t.max_id, nullptr);
+
+    // Timed pass: allocator work only
+    heap.init(arena.data(), arena.size());
+    auto start = std::chrono::steady_clock::now();
+    for (const TraceOp& op : t.ops) {
+        if (op.is_alloc) {
+            ptrs[op.id] = heap.allocate(op.size);
+        } else {
+            heap.deallocate(ptrs[op.id]);
+            ptrs[op.id] = nullptr;
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    // Untimed pass: track requested live bytes
+    heap.init(arena.data(), arena.size());
+    std::vector<uint32_t> sizes(t.max_id, 0);
+    size_t live = 0, peak_live = 0;
+    for (const TraceOp& op : t.ops) {
+        if (op.is_alloc) {
+            ptrs[op.id] = heap.allocate(op.size);
+            if (!ptrs[op.id]) continue;
+            sizes[op.id] = op.size;
+            live += op.size;
+            if (live > peak_live) peak_live = live;
+        } else if (ptrs[op.id]) {
+            live -= sizes[op.id];
+            heap.deallocate(ptrs[op.id]);
+            ptrs[op.id] = nullptr;
+        }
+    }
+
+    const TlsfHeap::Stats& stats = heap.get_stats();
+    Result r;
+    r.ns_per_op = std::chrono::duration<double, std::nano>(stop - start).count() / t.ops.size();
+    r.peak_live = peak_live;
+    r.footprint = stats.high_water_bytes;
+    r.failed = stats.failed_count;
+    return r;
+}
+
+// The previous SimpleAllocator: 8-byte aligned bump pointer, free is a no-op
+Result replay_bump(const Trace& t, std::vector<uint8_t>& arena) {
+    uint8_t* base = arena.data();
+    uint8_t* end = base + arena.size();
+    std::vector<void*> ptrs(t.max_id, nullptr);
+    std::vector<uint32_t> sizes(t.max_id, 0);
+
+    uint8_t* current = base;
+    uint32_t failed = 0;
+    size_t live = 0, peak_live = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const TraceOp& op : t.ops) {
+        if (op.is_alloc) {
+            size_t size = (op.size + 7) & ~size_t(7);
+            if (current + size > end) {
+                failed++;
+                ptrs[op.id] = nullptr;
+                continue;
+            }
+            ptrs[op.id] = current;
+            sizes[op.id] = op.size;
+            current += size;
+            live += op.size;
+            if (live > peak_live) peak_live = live;
+        } else if (ptrs[op.id]) {
+            live -= sizes[op.id];
+            ptrs[op.id] = nullptr;
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    Result r;
+    r.ns_per_op = std::chrono::duration<double, std::nano>(stop - start).count() / t.ops.size();
+    r.peak_live = peak_live;
+    r.footprint = current - base;
+    r.failed = failed;
+    return r;
+}
+
+void report(const char* trace, const char* allocator, size_t ops, const Result& r) {
+    // Share of the heap footprint not backing live data: headers, rounding
+    // and holes the allocator could not reuse
+    double frag = r.footprint ? 1.0 - double(r.peak_live) / double(r.footprint) : 0.0;
+    printf("%-18s %-5s ops=%-8zu ns/op=%-6.1f peak_live=%-9zu footprint=%-10zu "
+           "frag=%-5.3f failed=%u\n",
+           trace, allocator, ops, r.ns_per_op, r.peak_live, r.footprint, frag, r.failed);
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::vector<Trace> traces;
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            Trace t;
+            if (!load_trace(argv[i], t)) return 1;
+            traces.push_back(std::move(t));
+        }
+    } else {
+        traces.push_back(make_container_churn());
+        traces.push_back(make_mixed_sizes());
+        traces.push_back(make_growing_arrays());
+    }
+
+    std::vector<uint8_t> arena(HEAP_BYTES);
+    for (const Trace& t : traces) {
+        report(t.name.c_str(), "tlsf", t.ops.size(), replay_tlsf(t, arena));
+        report(t.name.c_str(), "bump", t.ops.size(), replay_bump(t, arena));
+    }
+    return 0;
+}
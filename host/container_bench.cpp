@@ -0,0 +1,176 @@
+// Host-side container throughput suite
+//
+// Self-contained take on Google Benchmark: each case runs one batch of
+// operations per call, the batch count doubles until a run takes at least
+// MIN_RUN_NS, and the best of REPEATS runs is reported as ns/op. The std::
+// containers run the same workloads as a baseline. Pass a substring to run
+// only matching cases, e.g. under perf or callgrind:
+//
+//   build/host/container_bench HashMap
+//   perf record -g build/host/container_bench SimpleMap/find
+//   valgrind --tool=callgrind build/host/container_bench FlatMap
+
+#include "simple_map.h"
+#include "hash_map.h"
+#include "flat_map.h"
+#include "simple_list.h"
+#include "ring_deque.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <map>
+#include <unordered_map>
+
+namespace {
+
+constexpr double MIN_RUN_NS = 2e8;
+constexpr int REPEATS = 3;
+constexpr uint32_t KEYS = 256;
+
+// Keeps results alive so the loops are not optimized away
+volatile uint64_t sink;
+
+// Keys in a scrambled but reproducible order
+uint32_t key_at(uint32_t index) {
+    return (index * 2654435761u) >> 8;
+}
+
+struct Case {
+    const char* name;
+    uint32_t ops_per_batch;
+    void (*batch)();
+};
+
+// --- Map workloads: build KEYS entries, look them all up, erase them ---
+
+template<typename Map>
+void map_insert() {
+    Map map;
+    for (uint32_t i = 0; i < KEYS; ++i) {
+        map[key_at(i)] = i;
+    }
+    sink = map.size();
+}
+
+template<typename Map>
+Map& prefilled() {
+    static Map map;
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < KEYS; ++i) {
+            map[key_at(i)] = i;
+        }
+        ready = true;
+    }
+    return map;
+}
+
+template<typename Map>
+void map_find() {
+    Map& map = prefilled<Map>();
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < KEYS; ++i) {
+        sum += *map.find(key_at(i));
+    }
+    sink = sum;
+}
+
+template<typename Map>
+void std_map_find() {
+    Map& map = prefilled<Map>();
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < KEYS; ++i) {
+        sum += map.find(key_at(i))->second;
+    }
+    sink = sum;
+}
+
+template<typename Map>
+void map_churn() {
+    Map map;
+    for (uint32_t i = 0; i < KEYS; ++i) {
+        map[key_at(i)] = i;
+    }
+    for (uint32_t i = 0; i < KEYS; ++i) {
+        map.erase(key_at(i));
+    }
+    sink = map.size();
+}
+
+// --- Sequence workloads: FIFO push_back/pop_front ---
+
+template<typename Sequence>
+void fifo() {
+    Sequence sequence;
+    for (uint32_t i = 0; i < KEYS; ++i) {
+        sequence.push_back(i);
+    }
+    uint64_t sum = 0;
+    while (!sequence.empty()) {
+        sum += sequence.front();
+        sequence.pop_front();
+    }
+    sink = sum;
+}
+
+const Case cases[] = {
+    {"SimpleMap/insert", KEYS, map_insert<SimpleMap<uint32_t, uint32_t>>},
+    {"HashMap/insert", KEYS, map_insert<HashMap<uint32_t, uint32_t>>},
+    {"FlatMap/insert", KEYS, map_insert<FlatMap<uint32_t, uint32_t>>},
+    {"std::map/insert", KEYS, map_insert<std::map<uint32_t, uint32_t>>},
+    {"std::unordered_map/insert", KEYS, map_insert<std::unordered_map<uint32_t, uint32_t>>},
+    {"SimpleMap/find", KEYS, map_find<SimpleMap<uint32_t, uint32_t>>},
+    {"HashMap/find", KEYS, map_find<HashMap<uint32_t, uint32_t>>},
+    {"FlatMap/find", KEYS, map_find<FlatMap<uint32_t, uint32_t>>},
+    {"std::map/find", KEYS, std_map_find<std::map<uint32_t, uint32_t>>},
+    {"std::unordered_map/find", KEYS, std_map_find<std::unordered_map<uint32_t, uint32_t>>},
+    {"SimpleMap/insert+erase", 2 * KEYS, map_churn<SimpleMap<uint32_t, uint32_t>>},
+    {"HashMap/insert+erase", 2 * KEYS, map_churn<HashMap<uint32_t, uint32_t>>},
+    {"FlatMap/insert+erase", 2 * KEYS, map_churn<FlatMap<uint32_t, uint32_t>>},
+    {"std::map/insert+erase", 2 * KEYS, map_churn<std::map<uint32_t, uint32_t>>},
+    {"SimpleList/fifo", 2 * KEYS, fifo<SimpleList<uint32_t>>},
+    {"RingDeque/fifo", 2 * KEYS, fifo<RingDeque<uint32_t>>},
+    {"std::list/fifo", 2 * KEYS, fifo<std::list<uint32_t>>},
+};
+
+double run_batches(const Case& c, uint64_t batches) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < batches; ++i) {
+        c.batch();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+void run_case(const Case& c) {
+    c.batch();  // warm caches and the prefilled maps
+
+    uint64_t batches = 1;
+    double ns = run_batches(c, batches);
+    while (ns < MIN_RUN_NS) {
+        batches *= 2;
+        ns = run_batches(c, batches);
+    }
+    for (int i = 1; i < REPEATS; ++i) {
+        double again = run_batches(c, batches);
+        if (again < ns) ns = again;
+    }
+
+    double ns_per_op = ns / (double(batches) * c.ops_per_batch);
+    std::printf("%-28s %12llu ops %9.2f ns/op %9.2f Mops/s\n", c.name,
+                (unsigned long long)(batches * c.ops_per_batch), ns_per_op, 1e3 / ns_per_op);
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    std::printf("%-28s %16s %15s %16s\n", "case", "ops", "time", "throughput");
+    for (const Case& c : cases) {
+        if (!filter || std::strstr(c.name, filter)) {
+            run_case(c);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,257 @@
+// Host-side unit tests for the firmware containers
+//
+// Each map and sequence container is driven through a long random sequence
+// of operations alongside the matching std:: container, and the two are
+// compared after every step. Element types count their live instances, so
+// a missing destructor or a double destroy fails the test even without a
+// sanitizer. Run under valgrind or -fsanitize=address to also check memory.
+
+#include "simple_map.h"
+#include "hash_map.h"
+#include "flat_map.h"
+#include "simple_list.h"
+#include "ring_deque.h"
+#include "small_vector.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+
+namespace {
+
+constexpr int OPERATIONS = 20000;
+constexpr uint32_t KEY_RANGE = 512;
+
+// Value type that tracks how many instances are alive
+struct Counted {
+    static long live;
+    uint32_t value;
+
+    Counted() : value(0) { ++live; }
+    explicit Counted(uint32_t v) : value(v) { ++live; }
+    Counted(const Counted& other) : value(other.value) { ++live; }
+    Counted(Counted&& other) noexcept : value(other.value) { ++live; }
+    Counted& operator=(const Counted& other) = default;
+    Counted& operator=(Counted&& other) noexcept = default;
+    ~Counted() { --live; }
+};
+
+long Counted::live = 0;
+
+// Compare every entry of a firmware map against the reference
+template<typename Map>
+bool same_contents(Map& map, const std::map<uint32_t, uint32_t>& reference) {
+    if (map.size() != reference.size()) return false;
+    size_t visited = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        auto found = reference.find(it.key());
+        if (found == reference.end() || found->second != it.value().value) return false;
+        ++visited;
+    }
+    return visited == reference.size();
+}
+
+template<typename Map>
+void test_map(const char* name) {
+    int failed_before = failures;
+    std::mt19937 rng(12345);
+    std::map<uint32_t, uint32_t> reference;
+    {
+        Map map;
+        for (int i = 0; i < OPERATIONS; ++i) {
+            uint32_t key = rng() % KEY_RANGE;
+            uint32_t value = rng();
+            switch (rng() % 5) {
+            case 0:
+                map.insert(key, Counted(value));
+                reference[key] = value;
+                break;
+            case 1:
+                map[key] = Counted(value);
+                reference[key] = value;
+                break;
+            case 2:
+                map.emplace_back(key, value);
+                reference[key] = value;
+                break;
+            case 3:
+                CHECK(map.erase(key) == (reference.erase(key) == 1));
+                break;
+            default: {
+                Counted* found = map.find(key);
+                auto expected = reference.find(key);
+                CHECK((found != nullptr) == (expected != reference.end()));
+                if (found && expected != reference.end()) {
+                    CHECK(found->value == expected->second);
+                }
+                break;
+            }
+            }
+            if (i % 1000 == 0) {
+                CHECK(same_contents(map, reference));
+            }
+        }
+        CHECK(same_contents(map, reference));
+        CHECK(Counted::live == (long)reference.size());
+
+        // Copy, move and clear keep the contents and the instance count right
+        Map copy(map);
+        CHECK(same_contents(copy, reference));
+        Map moved(std::move(copy));
+        CHECK(same_contents(moved, reference));
+        CHECK(Counted::live == 2 * (long)reference.size());
+        moved.clear();
+        CHECK(moved.size() == 0);
+        CHECK(!(moved.begin() != moved.end()));
+    }
+    CHECK(Counted::live == 0);
+    report(name, failed_before);
+}
+
+// FlatMap iterates in key order; check that on top of the contents
+void test_flat_map_order() {
+    int failed_before = failures;
+    FlatMap<uint32_t, Counted> map;
+    std::mt19937 rng(99);
+    for (int i = 0; i < 2000; ++i) {
+        map.insert(rng() % KEY_RANGE, Counted(i));
+    }
+    bool sorted = true;
+    bool first = true;
+    uint32_t previous = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        if (!first && it.key() <= previous) sorted = false;
+        previous = it.key();
+        first = false;
+    }
+    CHECK(sorted);
+    report("FlatMap order", failed_before);
+}
+
+template<typename Sequence>
+bool same_sequence(Sequence& sequence, const std::deque<uint32_t>& reference) {
+    if (sequence.size() != reference.size()) return false;
+    size_t index = 0;
+    for (auto it = sequence.begin(); it != sequence.end(); ++it) {
+        if ((*it).value != reference[index++]) return false;
+    }
+    return index == reference.size();
+}
+
+// Push/pop at both ends (front operations only where the container has them)
+template<typename Sequence, bool HasFront>
+void test_sequence(const char* name) {
+    int failed_before = failures;
+    std::mt19937 rng(777);
+    std::deque<uint32_t> reference;
+    {
+        Sequence sequence;
+        for (int i = 0; i < OPERATIONS; ++i) {
+            uint32_t value = rng();
+            // Bias toward growth early, shrinkage late, so sizes sweep up and down
+            bool grow = (rng() % 100) < (i < OPERATIONS / 2 ? 60u : 40u);
+            bool front = HasFront && (rng() & 1);
+            if (grow) {
+                if (front) {
+                    if constexpr (HasFront) sequence.push_front(Counted(value));
+                    reference.push_front(value);
+                } else {
+                    sequence.push_back(Counted(value));
+                    reference.push_back(value);
+                }
+            } else if (!reference.empty()) {
+                if (front) {
+                    if constexpr (HasFront) sequence.pop_front();
+                    reference.pop_front();
+                } else {
+                    sequence.pop_back();
+                    reference.pop_back();
+                }
+            }
+            if (!reference.empty()) {
+                CHECK(sequence.front().value == reference.front());
+                CHECK(sequence.back().value == reference.back());
+            }
+            if (i % 1000 == 0) {
+                CHECK(same_sequence(sequence, reference));
+            }
+        }
+        CHECK(same_sequence(sequence, reference));
+        CHECK(Counted::live == (long)reference.size());
+
+        Sequence copy(sequence);
+        CHECK(same_sequence(copy, reference));
+        Sequence moved(std::move(copy));
+        CHECK(same_sequence(moved, reference));
+        moved.clear();
+        CHECK(moved.empty());
+    }
+    CHECK(Counted::live == 0);
+    report(name, failed_before);
+}
+
+// SmallVector moves from inline storage to the heap once it outgrows N
+void test_small_vector_spill() {
+    int failed_before = failures;
+    SmallVector<Counted, 4> vector;
+    for (uint32_t i = 0; i < 4; ++i) vector.push_back(Counted(i));
+    CHECK(vector.is_small());
+    vector.push_back(Counted(4));
+    CHECK(!vector.is_small());
+    for (uint32_t i = 0; i < 5; ++i) CHECK(vector[i].value == i);
+    vector.clear();
+    CHECK(Counted::live == 0);
+    report("SmallVector spill", failed_before);
+}
+
+// Pushing an element of a full container into that same container: the
+// argument must survive the elements moving to a bigger buffer
+void test_self_insert() {
+    int failed_before = failures;
+    const std::string text(40, 'x');    // Past the SSO size, so a move empties it
+    RingDeque<std::string> deque;
+    while (deque.size() < 8) deque.push_back(text);
+    CHECK(deque.size() == deque.capacity());
+    deque.push_back(deque.front());
+    CHECK(deque.back() == text);
+    while (deque.size() < deque.capacity()) deque.push_back(text);
+    deque.push_front(deque.back());
+    CHECK(deque.front() == text);
+    CHECK(deque.size() == 17);
+    for (size_t i = 0; i < deque.size(); ++i) CHECK(deque[i] == text);
+
+    SmallVector<std::string, 4> vector;
+    while (vector.size() < 4) vector.push_back(text);
+    vector.push_back(vector.front());
+    CHECK(vector.back() == text);
+    while (vector.size() < vector.capacity()) vector.push_back(text);
+    vector.push_back(vector[0]);
+    CHECK(vector.size() == 9);
+    for (size_t i = 0; i < vector.size(); ++i) CHECK(vector[i] == text);
+    report("self insert when full", failed_before);
+}
+
+}
+
+int main() {
+    test_map<SimpleMap<uint32_t, Counted>>("SimpleMap");
+    test_map<HashMap<uint32_t, Counted>>("HashMap");
+    test_map<FlatMap<uint32_t, Counted>>("FlatMap");
+    test_flat_map_order();
+    test_sequence<SimpleList<Counted>, true>("SimpleList");
+    test_sequence<RingDeque<Counted>, true>("RingDeque");
+    test_sequence<SmallVector<Counted, 8>, false>("SmallVector");
+    test_small_vector_spill();
+    test_self_insert();
+
+    if (failures) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all container tests passed\n");
+    return 0;
+}
@@ -0,0 +1,160 @@
+// Host-side queue benchmark: RingDeque / SmallVector vs SimpleList
+//
+// Global operator new is routed to a TlsfHeap as on target, and SimpleList
+// uses its default slab node allocator, so the comparison is between the
+// containers as the firmware builds them.
+
+#include "tlsf_heap.h"
+#include "simple_list.h"
+#include "ring_deque.h"
+#include "small_vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+constexpr size_t HEAP_BYTES = 64u << 20;
+alignas(16) uint8_t heap_arena[HEAP_BYTES];
+TlsfHeap heap;
+bool heap_ready = false;
+
+TlsfHeap& firmware_heap() {
+    if (!heap_ready) {
+        heap.init(heap_arena, sizeof(heap_arena));
+        heap_ready = true;
+    }
+    return heap;
+}
+
+}
+
+void* operator new(size_t size) {
+    void* ptr = firmware_heap().allocate(size);
+    if (!ptr) std::abort();
+    return ptr;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { firmware_heap().deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { firmware_heap().deallocate(ptr); }
+void operator delete(void* ptr, size_t size) noexcept { firmware_heap().deallocate(ptr, size); }
+void operator delete[](void* ptr, size_t size) noexcept { firmware_heap().deallocate(ptr, size); }
+
+namespace {
+
+constexpr int QUEUE_DEPTH = 256;
+constexpr int FIFO_ROUNDS = 2000000;
+constexpr int BURST_ROUNDS = 20000;
+constexpr int ITERATE_ROUNDS = 20000;
+constexpr int STACK_DEPTH = 8;
+constexpr int STACK_ROUNDS = 500000;
+
+// Keeps results alive so the loops are not optimized away
+volatile long sink;
+
+double elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Steady-state FIFO: one push_back and one pop_front per round
+template<typename Queue>
+double fifo_churn() {
+    Queue queue;
+    for (int i = 0; i < QUEUE_DEPTH; ++i) {
+        queue.push_back(i);
+    }
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FIFO_ROUNDS; ++i) {
+        sum += queue.front();
+        queue.pop_front();
+        queue.push_back(i);
+    }
+    double ns = elapsed_ns(start);
+    sink = sum;
+    return ns / (2.0 * FIFO_ROUNDS);
+}
+
+// Fill to QUEUE_DEPTH then drain from the front, repeatedly
+template<typename Queue>
+double burst_fill_drain() {
+    Queue queue;
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < BURST_ROUNDS; ++round) {
+        for (int i = 0; i < QUEUE_DEPTH; ++i) {
+            queue.push_back(i);
+        }
+        while (!queue.empty()) {
+            sum += queue.front();
+            queue.pop_front();
+        }
+    }
+    double ns = elapsed_ns(start);
+    sink = sum;
+    return ns / (2.0 * BURST_ROUNDS * QUEUE_DEPTH);
+}
+
+// Walk a full queue with the container iterator
+template<typename Queue>
+double iterate() {
+    Queue queue;
+    for (int i = 0; i < QUEUE_DEPTH; ++i) {
+        queue.push_back(i);
+    }
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ITERATE_ROUNDS; ++round) {
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            sum += *it;
+        }
+    }
+    double ns = elapsed_ns(start);
+    sink = sum;
+    return ns / (double(ITERATE_ROUNDS) * QUEUE_DEPTH);
+}
+
+// Short-lived scratch stack built in a local, the SmallVector case
+template<typename Stack>
+double scratch_stack() {
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < STACK_ROUNDS; ++round) {
+        Stack stack;
+        for (int i = 0; i < STACK_DEPTH; ++i) {
+            stack.push_back(round + i);
+        }
+        while (!stack.empty()) {
+            sum += stack.back();
+            stack.pop_back();
+        }
+    }
+    double ns = elapsed_ns(start);
+    sink = sum;
+    return ns / (2.0 * STACK_ROUNDS * STACK_DEPTH);
+}
+
+void report(const char* workload, const char* container, double ns_per_op) {
+    printf("%-16s %-16s ns/op=%.2f\n", workload, container, ns_per_op);
+}
+
+}
+
+int main() {
+    report("fifo_churn", "SimpleList", fifo_churn<SimpleList<int>>());
+    report("fifo_churn", "RingDeque", fifo_churn<RingDeque<int>>());
+
+    report("burst_fill_drain", "SimpleList", burst_fill_drain<SimpleList<int>>());
+    report("burst_fill_drain", "RingDeque", burst_fill_drain<RingDeque<int>>());
+
+    report("iterate", "SimpleList", iterate<SimpleList<int>>());
+    report("iterate", "RingDeque", iterate<RingDeque<int>>());
+    report("iterate", "SmallVector<16>", iterate<SmallVector<int, 16>>());
+
+    report("scratch_stack", "SimpleList", scratch_stack<SimpleList<int>>());
+    report("scratch_stack", "RingDeque", scratch_stack<RingDeque<int>>());
+    report("scratch_stack", "SmallVector<8>", scratch_stack<SmallVector<int, 8>>());
+    return 0;
+}
@@ -0,0 +1,117 @@
+// Host-side unit tests for the binary log record format
+//
+// src/lib/log_format.cpp is linked into this binary: the same formatter
+// the firmware's drain task runs. Checks every conversion, padding,
+// truncation and missing arguments, and round-trips variable-length
+// records through an SpscRing the way BinLog does, including the
+// all-or-nothing push when the ring is nearly full.
+
+#include "log_format.h"
+#include "spsc_ring.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char* const strings[] = {"yes", "no"};
+
+// %s arguments in these tests are indexes into strings[]
+const char* resolve_index(uint32_t address, void*) {
+    return address < 2 ? strings[address] : nullptr;
+}
+
+bool formats_to(const char* expected, const char* format, const uint32_t* args, uint32_t count) {
+    char out[128];
+    size_t len = LogFormatter::format(out, sizeof(out), format, args, count, resolve_index, nullptr);
+    bool ok = len == std::strlen(expected) && std::strcmp(out, expected) == 0;
+    if (!ok) {
+        std::printf("  format \"%s\" gave \"%s\", expected \"%s\"\n", format, out, expected);
+    }
+    return ok;
+}
+
+void test_conversions() {
+    int failed_before = failures;
+    const uint32_t args[] = {42, (uint32_t)-42, 0xBEEF, 'A', 1, 0};
+    const uint32_t padded[] = {42, 42, (uint32_t)-42, (uint32_t)-42};
+    const uint32_t extremes[] = {0x80000000u, 100, 7};
+    CHECK(formats_to("plain text\n", "plain text\n", nullptr, 0));
+    CHECK(formats_to("42 -42 beef A no", "%u %d %x %c %s", args, 5));
+    CHECK(formats_to("4294967254", "%u", args + 1, 1));
+    CHECK(formats_to("0 ?", "%d %u", args + 5, 1));
+    CHECK(formats_to("[   42] [00042] [  -42] [-0042]", "[%5u] [%05u] [%5d] [%05d]", padded, 4));
+    CHECK(formats_to("0000beef", "%08x", args + 2, 1));
+    CHECK(formats_to("-2147483648", "%d", extremes, 1));
+    CHECK(formats_to("100%", "%u%%", extremes + 1, 1));
+    CHECK(formats_to("(null)", "%s", extremes + 2, 1));
+    CHECK(formats_to("%q", "%q", args, 1));
+    CHECK(formats_to("trailing ", "trailing %", args, 1));
+    report("conversions", failed_before);
+}
+
+void test_truncation() {
+    int failed_before = failures;
+    char out[8];
+    std::memset(out, 'x', sizeof(out));
+    const uint32_t args[] = {123456};
+    size_t len = LogFormatter::format(out, sizeof(out), "n=%u!!", args, 1, nullptr, nullptr);
+    CHECK(len == 7);
+    CHECK(std::strcmp(out, "n=12345") == 0);
+    CHECK(LogFormatter::format(out, 1, "abc", nullptr, 0, nullptr, nullptr) == 0);
+    CHECK(out[0] == '\0');
+    CHECK(LogFormatter::format(out, 0, "abc", nullptr, 0, nullptr, nullptr) == 0);
+    report("truncation", failed_before);
+}
+
+void test_records() {
+    int failed_before = failures;
+    static SpscRing<uint32_t, 16> ring;
+
+    CHECK(LogRecord::site_of(LogRecord::header(0x123456, 3)) == 0x123456);
+    CHECK(LogRecord::arg_count_of(LogRecord::header(0x123456, 3)) == 3);
+
+    // Records of 2, 5 and 7 words: the third doesn't fit and is refused whole
+    const uint32_t first[] = {LogRecord::header(1, 0), 100};
+    const uint32_t second[] = {LogRecord::header(2, 3), 200, 7, 8, 9};
+    const uint32_t third[] = {LogRecord::header(3, 5), 300, 1, 2, 3, 4, 5};
+    CHECK(ring.try_push_batch(first, 2));
+    CHECK(ring.try_push_batch(second, 5));
+    CHECK(ring.try_push_batch(second, 5));
+    CHECK(!ring.try_push_batch(third, 7));
+    CHECK(ring.size() == 12);
+
+    // Consume the way BinLog::drain_one does: header, then the rest
+    uint32_t header = 0;
+    uint32_t words[LogRecord::MAX_WORDS];
+    CHECK(ring.try_pop(header) && LogRecord::site_of(header) == 1);
+    CHECK(ring.pop_batch(words, 1 + LogRecord::arg_count_of(header)) == 1 && words[0] == 100);
+    CHECK(ring.try_pop(header) && LogRecord::site_of(header) == 2);
+    CHECK(ring.pop_batch(words, 1 + LogRecord::arg_count_of(header)) == 4);
+    CHECK(words[0] == 200 && words[1] == 7 && words[3] == 9);
+
+    // Room again once drained, and the record wraps around the ring end
+    CHECK(ring.try_push_batch(third, 7));
+    CHECK(ring.try_pop(header) && LogRecord::site_of(header) == 2);
+    CHECK(ring.pop_batch(words, 4) == 4);
+    CHECK(ring.try_pop(header) && LogRecord::site_of(header) == 3);
+    CHECK(ring.pop_batch(words, 6) == 6 && words[0] == 300 && words[5] == 5);
+    CHECK(ring.empty());
+    report("records", failed_before);
+}
+
+}
+
+int main() {
+    test_conversions();
+    test_truncation();
+    test_records();
+
+    if (failures) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all log format tests passed\n");
+    return 0;
+}
@@ -0,0 +1,136 @@
+// Host-side node churn benchmark: slab allocator vs global operator new
+//
+// Global operator new is routed to a TlsfHeap here, exactly as on target,
+// so both paths measure the firmware allocators rather than glibc malloc.
+
+#include "tlsf_heap.h"
+#include "slab_allocator.h"
+#include "simple_map.h"
+#include "simple_list.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+
+constexpr size_t HEAP_BYTES = 64u << 20;
+alignas(16) uint8_t heap_arena[HEAP_BYTES];
+TlsfHeap heap;
+bool heap_ready = false;
+
+TlsfHeap& firmware_heap() {
+    if (!heap_ready) {
+        heap.init(heap_arena, sizeof(heap_arena));
+        heap_ready = true;
+    }
+    return heap;
+}
+
+}
+
+void* operator new(size_t size) {
+    void* ptr = firmware_heap().allocate(size);
+    if (!ptr) std::abort();
+    return ptr;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { firmware_heap().deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { firmware_heap().deallocate(ptr); }
+void operator delete(void* ptr, size_t size) noexcept { firmware_heap().deallocate(ptr, size); }
+void operator delete[](void* ptr, size_t size) noexcept { firmware_heap().deallocate(ptr, size); }
+
+namespace {
+
+constexpr int MAP_KEYS = 512;
+constexpr int MAP_ROUNDS = 200000;
+constexpr int QUEUE_DEPTH = 256;
+constexpr int QUEUE_ROUNDS = 2000000;
+
+struct Result {
+    double ns_per_op;
+    size_t heap_bytes;      // Heap bytes held by the allocator path at peak
+};
+
+// Heap bytes held including the per-block header
+size_t heap_held() {
+    const TlsfHeap::Stats& stats = firmware_heap().get_stats();
+    return stats.used_bytes + (stats.alloc_count - stats.free_count) * TlsfHeap::ALIGN_SIZE;
+}
+
+uint32_t lcg(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+template<typename Alloc>
+Result map_churn() {
+    size_t base = heap_held();
+    SimpleMap<int, int, Alloc> map;
+    uint32_t rng = 7;
+    for (int i = 0; i < MAP_KEYS; ++i) {
+        map.insert(i, i);
+    }
+    size_t peak = heap_held() - base;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < MAP_ROUNDS; ++i) {
+        int key = lcg(rng) % MAP_KEYS;
+        map.erase(key);
+        map.insert(key, i);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    size_t held = heap_held() - base;
+    Result r;
+    r.ns_per_op = std::chrono::duration<double, std::nano>(stop - start).count() / (2.0 * MAP_ROUNDS);
+    r.heap_bytes = held > peak ? held : peak;
+    return r;
+}
+
+template<typename Alloc>
+Result queue_churn() {
+    size_t base = heap_held();
+    SimpleList<int, Alloc> list;
+    for (int i = 0; i < QUEUE_DEPTH; ++i) {
+        list.push_back(i);
+    }
+    size_t peak = heap_held() - base;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < QUEUE_ROUNDS; ++i) {
+        list.pop_front();
+        list.push_back(i);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    size_t held = heap_held() - base;
+    Result r;
+    r.ns_per_op = std::chrono::duration<double, std::nano>(stop - start).count() / (2.0 * QUEUE_ROUNDS);
+    r.heap_bytes = held > peak ? held : peak;
+    return r;
+}
+
+void report(const char* workload, const char* path, const Result& r) {
+    printf("%-14s %-7s ns/op=%-6.1f heap_bytes=%zu\n", workload, path, r.ns_per_op, r.heap_bytes);
+}
+
+}
+
+int main() {
+    report("map_churn", "global", map_churn<GlobalNodeAllocator>());
+    report("map_churn", "slab", map_churn<SlabNodeAllocator>());
+    report("queue_churn", "global", queue_churn<GlobalNodeAllocator>());
+    report("queue_churn", "slab", queue_churn<SlabNodeAllocator>());
+
+    printf("slab classes (size slabs capacity in_use peak):\n");
+    for (uint32_t i = 0; i < SlabAllocator::CLASS_COUNT; ++i) {
+        SlabAllocator::ClassStats stats = SlabAllocator::get_class_stats(i);
+        if (!stats.slab_count) continue;
+        printf("  %3u %4u %6u %6u %6u\n", stats.object_size, stats.slab_count,
+               stats.capacity, stats.in_use, stats.peak_in_use);
+    }
+    return 0;
+}
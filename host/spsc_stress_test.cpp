@@ -0,0 +1,104 @@
+// Host-side two-thread stress test for SpscRing
+//
+// One thread produces a numbered stream with a mix of single and batch
+// pushes, the other consumes it with single and batch pops and checks that
+// every item arrives exactly once, in order and untorn. Build with
+// -fsanitize=thread to also have TSan check the memory ordering.
+
+#include "spsc_ring.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+constexpr uint32_t ITEMS = 4000000;
+
+// Payload wider than one word so a missing fence shows up as a torn item
+struct Item {
+    uint32_t sequence;
+    uint32_t check;
+};
+
+uint32_t check_of(uint32_t sequence) {
+    return sequence * 2654435761u ^ 0x5bd1e995u;
+}
+
+template<uint32_t Capacity>
+bool stress(const char* name) {
+    static SpscRing<Item, Capacity> ring;
+    uint32_t errors = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([] {
+        uint32_t next = 0;
+        Item batch[Capacity];
+        while (next < ITEMS) {
+            // Alternate single pushes with batches of varying size
+            uint32_t want = (next % 7) + 1;
+            if (want > Capacity) want = Capacity;
+            if (want > ITEMS - next) want = ITEMS - next;
+            if (want == 1) {
+                Item item = {next, check_of(next)};
+                if (ring.try_push(item)) {
+                    next++;
+                } else {
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+            for (uint32_t i = 0; i < want; ++i) {
+                batch[i].sequence = next + i;
+                batch[i].check = check_of(next + i);
+            }
+            uint32_t pushed = ring.push_batch(batch, want);
+            if (!pushed) {
+                // Full: let the consumer run when both share a core
+                std::this_thread::yield();
+            }
+            next += pushed;
+        }
+    });
+
+    std::thread consumer([&errors] {
+        uint32_t expected = 0;
+        Item batch[Capacity];
+        while (expected < ITEMS) {
+            uint32_t got;
+            if (expected % 3 == 0) {
+                got = ring.try_pop(batch[0]) ? 1 : 0;
+            } else {
+                got = ring.pop_batch(batch, (expected % 5) + 2);
+            }
+            if (!got) {
+                std::this_thread::yield();
+            }
+            for (uint32_t i = 0; i < got; ++i) {
+                if (batch[i].sequence != expected || batch[i].check != check_of(expected)) {
+                    errors++;
+                }
+                expected++;
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool ok = errors == 0 && ring.empty();
+    printf("%-12s capacity=%-5u items=%u Mitems/s=%.1f errors=%u %s\n", name, Capacity, ITEMS,
+           ITEMS / seconds / 1e6, errors, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+}
+
+int main() {
+    bool ok = true;
+    ok &= stress<2>("tiny_ring");
+    ok &= stress<16>("small_ring");
+    ok &= stress<1024>("large_ring");
+    return ok ? 0 : 1;
+}
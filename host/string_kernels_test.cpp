@@ -0,0 +1,94 @@
+// Host-side unit tests for the string kernels
+//
+// src/lib/string_kernels.cpp is linked into this binary, so its memcpy,
+// memset and strlen replace the C library's here too. Every size up to a
+// few hundred bytes is tried at every source/destination alignment and
+// compared with the byte-loop references; guard bytes around each buffer
+// catch writes past either end.
+
+#include "string_kernels.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr size_t MAX_SIZE = 300;
+constexpr size_t GUARD = 16;
+constexpr uint8_t GUARD_BYTE = 0xA5;
+
+alignas(16) uint8_t source[MAX_SIZE + 2 * GUARD];
+alignas(16) uint8_t actual[MAX_SIZE + 2 * GUARD];
+alignas(16) uint8_t expected[MAX_SIZE + 2 * GUARD];
+
+void fill_source() {
+    for (size_t i = 0; i < sizeof(source); ++i) {
+        source[i] = (uint8_t)(i * 37 + 11);
+    }
+}
+
+void test_memcpy() {
+    int failed_before = failures;
+    fill_source();
+    for (size_t size = 0; size <= MAX_SIZE; ++size) {
+        for (size_t src_offset = 0; src_offset < 8; ++src_offset) {
+            for (size_t dst_offset = 0; dst_offset < 8; ++dst_offset) {
+                StringKernels::set_bytes(actual, GUARD_BYTE, sizeof(actual));
+                StringKernels::set_bytes(expected, GUARD_BYTE, sizeof(expected));
+                void* result = memcpy(actual + GUARD + dst_offset, source + src_offset, size);
+                StringKernels::copy_bytes(expected + GUARD + dst_offset, source + src_offset, size);
+                CHECK(result == actual + GUARD + dst_offset);
+                CHECK(std::memcmp(actual, expected, sizeof(actual)) == 0);
+            }
+        }
+    }
+    report("memcpy", failed_before);
+}
+
+void test_memset() {
+    int failed_before = failures;
+    for (size_t size = 0; size <= MAX_SIZE; ++size) {
+        for (size_t offset = 0; offset < 8; ++offset) {
+            int value = (int)(size * 7 + offset) | 0x100;  // only the low byte counts
+            StringKernels::set_bytes(actual, GUARD_BYTE, sizeof(actual));
+            StringKernels::set_bytes(expected, GUARD_BYTE, sizeof(expected));
+            void* result = memset(actual + GUARD + offset, value, size);
+            StringKernels::set_bytes(expected + GUARD + offset, value, size);
+            CHECK(result == actual + GUARD + offset);
+            CHECK(std::memcmp(actual, expected, sizeof(actual)) == 0);
+        }
+    }
+    report("memset", failed_before);
+}
+
+void test_strlen() {
+    int failed_before = failures;
+    for (size_t length = 0; length <= MAX_SIZE; ++length) {
+        for (size_t offset = 0; offset < 8; ++offset) {
+            char* str = reinterpret_cast<char*>(actual + offset);
+            StringKernels::set_bytes(actual, 'x', sizeof(actual));
+            str[length] = '\0';
+            // Bytes with the high bit set must not look like terminators
+            if (length > 2) str[length - 2] = (char)0x80;
+            CHECK(strlen(str) == length);
+            CHECK(StringKernels::length_bytes(str) == length);
+        }
+    }
+    report("strlen", failed_before);
+}
+
+}
+
+int main() {
+    test_memcpy();
+    test_memset();
+    test_strlen();
+
+    if (failures) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all string kernel tests passed\n");
+    return 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// CHECK() and per-test result lines shared by the host unit tests
+//
+//   void test_thing() {
+//       int failed_before = failures;
+//       CHECK(thing() == 42);
+//       report("thing", failed_before);
+//   }
+//
+// failures counts every failed CHECK of the run, for main()'s exit code;
+// report() prints FAILED only when the test's own checks failed.
+
+#include <cstdio>
+
+inline int failures = 0;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            ++failures; \
+        } \
+    } while (0)
+
+inline void report(const char* name, int failed_before) {
+    std::printf("%-28s %s\n", name, failures > failed_before ? "FAILED" : "ok");
+}
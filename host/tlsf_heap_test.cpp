@@ -0,0 +1,152 @@
+// Host-side unit tests for TlsfHeap
+//
+// Random allocate/free traffic over a private arena. Every live block is
+// filled with a pattern derived from its address and re-checked before it
+// is freed, so overlapping blocks or a header overwritten by a neighbour
+// show up as a corrupted pattern. Once everything is freed the heap must
+// coalesce back into a single block.
+
+#include "tlsf_heap.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t ARENA_BYTES = 4u << 20;
+constexpr int OPERATIONS = 200000;
+constexpr size_t MAX_LIVE = 512;
+
+alignas(16) uint8_t arena[ARENA_BYTES];
+
+struct Live {
+    uint8_t* ptr;
+    size_t size;
+};
+
+uint8_t pattern_of(const uint8_t* ptr) {
+    return static_cast<uint8_t>(reinterpret_cast<uintptr_t>(ptr) >> 4) | 1;
+}
+
+bool pattern_intact(const Live& block) {
+    uint8_t expected = pattern_of(block.ptr);
+    for (size_t i = 0; i < block.size; ++i) {
+        if (block.ptr[i] != expected) return false;
+    }
+    return true;
+}
+
+// Mostly small requests with an occasional large one, like the firmware
+size_t random_size(std::mt19937& rng) {
+    uint32_t roll = rng() % 100;
+    if (roll < 70) return 1 + rng() % 64;
+    if (roll < 95) return 64 + rng() % 1024;
+    return 1024 + rng() % (64 * 1024);
+}
+
+void test_random_traffic() {
+    int failed_before = failures;
+    TlsfHeap heap;
+    heap.init(arena, sizeof(arena));
+    size_t initial_free = heap.get_free_memory();
+    size_t initial_largest = heap.get_largest_free_block();
+
+    std::mt19937 rng(2024);
+    std::vector<Live> live;
+    for (int i = 0; i < OPERATIONS; ++i) {
+        bool allocate = live.empty() || (live.size() < MAX_LIVE && (rng() & 1));
+        if (allocate) {
+            size_t size = random_size(rng);
+            uint8_t* ptr = static_cast<uint8_t*>(heap.allocate(size));
+            CHECK(ptr != nullptr);
+            if (!ptr) continue;
+            CHECK(reinterpret_cast<uintptr_t>(ptr) % TlsfHeap::ALIGN_SIZE == 0);
+            CHECK(TlsfHeap::usable_size(ptr) >= size);
+            CHECK(ptr >= arena && ptr + size <= arena + sizeof(arena));
+            std::memset(ptr, pattern_of(ptr), size);
+            live.push_back(Live{ptr, size});
+        } else {
+            size_t index = rng() % live.size();
+            Live block = live[index];
+            live[index] = live.back();
+            live.pop_back();
+            CHECK(pattern_intact(block));
+            // Alternate plain and sized frees
+            if (i & 1) {
+                heap.deallocate(block.ptr);
+            } else {
+                heap.deallocate(block.ptr, block.size);
+            }
+        }
+    }
+
+    for (const Live& block : live) {
+        CHECK(pattern_intact(block));
+        heap.deallocate(block.ptr);
+    }
+
+    const TlsfHeap::Stats& stats = heap.get_stats();
+    CHECK(stats.alloc_count == stats.free_count);
+    CHECK(stats.used_bytes == 0);
+    CHECK(stats.bad_free_count == 0);
+    CHECK(heap.get_free_memory() == initial_free);
+    CHECK(heap.get_largest_free_block() == initial_largest);
+    report("random traffic", failed_before);
+}
+
+void test_exhaustion() {
+    int failed_before = failures;
+    TlsfHeap heap;
+    heap.init(arena, 64 * 1024);
+
+    std::vector<void*> blocks;
+    while (void* ptr = heap.allocate(1024)) {
+        blocks.push_back(ptr);
+    }
+    CHECK(!blocks.empty());
+    CHECK(heap.get_stats().failed_count == 1);
+    CHECK(heap.allocate(sizeof(arena)) == nullptr);
+
+    for (void* ptr : blocks) {
+        heap.deallocate(ptr);
+    }
+    // Fully coalesced again, so a single large request fits
+    CHECK(heap.allocate(32 * 1024) != nullptr);
+    report("exhaustion", failed_before);
+}
+
+void test_bad_free() {
+    int failed_before = failures;
+    TlsfHeap heap;
+    heap.init(arena, 64 * 1024);
+
+    void* ptr = heap.allocate(100);
+    heap.deallocate(ptr);
+    heap.deallocate(ptr);
+    CHECK(heap.get_stats().bad_free_count == 1);
+
+    // Sized delete larger than the block is rejected, not trusted
+    void* other = heap.allocate(32);
+    heap.deallocate(other, 4096);
+    CHECK(heap.get_stats().bad_free_count == 2);
+    heap.deallocate(nullptr);
+    report("bad free", failed_before);
+}
+
+}
+
+int main() {
+    test_random_traffic();
+    test_exhaustion();
+    test_bad_free();
+
+    if (failures) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all heap tests passed\n");
+    return 0;
+}
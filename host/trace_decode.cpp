@@ -0,0 +1,135 @@
+// Decode the firmware's binary log on the host
+//
+//   trace_decode [--elf FILE] (--capture FILE | --dump FILE [--dump-base ADDR])
+//                [--histograms] [--chrome FILE] [--cycles-per-us N] [--quiet]
+//
+// --capture reads a UART capture of a LOG_RAW=1 build ("-" for stdin) and
+// prints the console output with every frame formatted back into its line.
+// --dump reads a raw memory image (QEMU monitor pmemsave) starting at
+// --dump-base and prints the records still waiting in the rings. Either
+// way --histograms prints per-probe latency histograms (PROFILE_TRACE=1
+// samples, or the probe table itself in a dump) and --chrome writes a
+// timeline for chrome://tracing or Perfetto.
+
+#include "trace_decoder.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+void usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--elf FILE] (--capture FILE | --dump FILE [--dump-base ADDR])\n"
+                 "       [--histograms] [--chrome FILE] [--cycles-per-us N] [--quiet]\n",
+                 program);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* elf_path = "build/riscv-program.elf";
+    const char* capture_path = nullptr;
+    const char* dump_path = nullptr;
+    const char* chrome_path = nullptr;
+    uint32_t dump_base = 0x84000000;
+    bool histograms = false;
+    bool quiet = false;
+    TraceDecoderOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool takes_value = true;
+        if (std::strcmp(arg, "--elf") == 0 && value) {
+            elf_path = value;
+        } else if (std::strcmp(arg, "--capture") == 0 && value) {
+            capture_path = value;
+        } else if (std::strcmp(arg, "--dump") == 0 && value) {
+            dump_path = value;
+        } else if (std::strcmp(arg, "--dump-base") == 0 && value) {
+            dump_base = (uint32_t)std::strtoul(value, nullptr, 0);
+        } else if (std::strcmp(arg, "--chrome") == 0 && value) {
+            chrome_path = value;
+        } else if (std::strcmp(arg, "--cycles-per-us") == 0 && value) {
+            options.cycles_per_us = std::strtod(value, nullptr);
+        } else if (std::strcmp(arg, "--histograms") == 0) {
+            histograms = true;
+            takes_value = false;
+        } else if (std::strcmp(arg, "--quiet") == 0) {
+            quiet = true;
+            takes_value = false;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+        i += takes_value;
+    }
+    if (!capture_path == !dump_path || options.cycles_per_us <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    ElfImage elf;
+    std::string error;
+    if (!elf.load(elf_path, error)) {
+        std::fprintf(stderr, "trace_decode: %s\n", error.c_str());
+        return 1;
+    }
+
+    FILE* chrome = nullptr;
+    if (chrome_path && !(chrome = std::fopen(chrome_path, "w"))) {
+        std::fprintf(stderr, "trace_decode: cannot write %s\n", chrome_path);
+        return 1;
+    }
+    options.text = quiet ? nullptr : stdout;
+    options.chrome = chrome;
+
+    TraceDecoder decoder(elf, options);
+    if (!decoder.init(error)) {
+        std::fprintf(stderr, "trace_decode: %s: %s\n", elf_path, error.c_str());
+        return 1;
+    }
+
+    const char* input_path = capture_path ? capture_path : dump_path;
+    bool from_stdin = capture_path && std::strcmp(capture_path, "-") == 0;
+    FILE* input = from_stdin ? stdin : std::fopen(input_path, "rb");
+    if (!input) {
+        std::fprintf(stderr, "trace_decode: cannot open %s\n", input_path);
+        return 1;
+    }
+
+    bool ok = capture_path ? decoder.decode_capture(input)
+                           : decoder.decode_dump(input, dump_base, error);
+    if (!from_stdin) {
+        std::fclose(input);
+    }
+    decoder.finish();
+    if (chrome) {
+        std::fclose(chrome);
+    }
+    if (!ok) {
+        std::fprintf(stderr, "trace_decode: %s: %s\n", input_path,
+                     error.empty() ? "read error" : error.c_str());
+        return 1;
+    }
+
+    if (histograms) {
+        decoder.print_histograms(stdout);
+    }
+
+    const TraceDecoderStats& stats = decoder.get_stats();
+    std::fprintf(stderr, "trace_decode: %llu records, %llu probe samples, %llu text bytes",
+                 (unsigned long long)stats.records, (unsigned long long)stats.probe_samples,
+                 (unsigned long long)stats.text_bytes);
+    if (dump_path) {
+        std::fprintf(stderr, ", %llu dropped on target", (unsigned long long)stats.dropped);
+    }
+    if (stats.bad_sites) {
+        std::fprintf(stderr, ", %llu bad site IDs (ELF doesn't match the capture?)",
+                     (unsigned long long)stats.bad_sites);
+    }
+    std::fputc('\n', stderr);
+    return 0;
+}
@@ -0,0 +1,513 @@
+#include "trace_decoder.h"
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <elf.h>
+
+// ProfileProbe as laid out by the RV32 firmware (lib/profiler.h): name
+// pointer, id, count, min, max, then 8-byte aligned 64-bit totals and the
+// bucket array
+static constexpr uint32_t PROBE_NAME_OFFSET = 0;
+static constexpr uint32_t PROBE_COUNT_OFFSET = 8;
+static constexpr uint32_t PROBE_MIN_OFFSET = 12;
+static constexpr uint32_t PROBE_MAX_OFFSET = 16;
+static constexpr uint32_t PROBE_TOTAL_OFFSET = 24;
+static constexpr uint32_t PROBE_BUCKETS_OFFSET = 48;
+static constexpr uint32_t PROBE_BYTES = PROBE_BUCKETS_OFFSET + 4 * ProbeHistogram::BUCKET_COUNT;
+
+// Firmware symbols read from memory dumps
+static const char* const HARTS_SYMBOL = "_ZN6BinLog5hartsE";
+static const char* const PROBES_SYMBOL = "_ZN8Profiler6probesE";
+static const char* const PROBE_TOTAL_SYMBOL = "_ZN8Profiler11probe_totalE";
+
+// LogHartBuffer with its ring's private counters spelled out; the static
+// asserts keep it in step with the real one
+struct RingImage {
+    alignas(64) uint32_t tail;
+    alignas(64) uint32_t head;
+    alignas(64) uint32_t slots[LogRecord::RING_WORDS];
+};
+
+struct alignas(64) HartBufferImage {
+    RingImage ring;
+    uint32_t written;
+    uint32_t dropped;
+};
+
+static_assert(sizeof(HartBufferImage) == sizeof(LogHartBuffer), "ring layout changed");
+static_assert(offsetof(HartBufferImage, written) == offsetof(LogHartBuffer, written),
+              "ring layout changed");
+
+static uint32_t load_le32(const uint8_t* bytes) {
+    return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 |
+           (uint32_t)bytes[3] << 24;
+}
+
+static bool read_at(FILE* file, uint64_t offset, void* out, size_t size) {
+    return fseeko(file, (off_t)offset, SEEK_SET) == 0 && fread(out, 1, size, file) == size;
+}
+
+bool ElfImage::load(const char* path, std::string& error) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        error = std::string("cannot open ") + path;
+        return false;
+    }
+
+    Elf32_Ehdr header;
+    bool ok = read_at(file, 0, &header, sizeof(header)) &&
+              std::memcmp(header.e_ident, ELFMAG, SELFMAG) == 0 &&
+              header.e_ident[EI_CLASS] == ELFCLASS32 && header.e_ident[EI_DATA] == ELFDATA2LSB &&
+              header.e_shentsize == sizeof(Elf32_Shdr);
+    std::vector<Elf32_Shdr> headers(ok ? header.e_shnum : 0);
+    if (ok && !headers.empty()) {
+        ok = read_at(file, header.e_shoff, headers.data(), headers.size() * sizeof(Elf32_Shdr));
+    }
+    if (!ok) {
+        error = std::string(path) + " is not a readable ELF32 little-endian file";
+        std::fclose(file);
+        return false;
+    }
+
+    for (const Elf32_Shdr& section : headers) {
+        if (section.sh_type == SHT_PROGBITS && (section.sh_flags & SHF_ALLOC) && section.sh_size) {
+            Section loaded = {section.sh_addr, std::vector<uint8_t>(section.sh_size)};
+            if (!read_at(file, section.sh_offset, loaded.data.data(), section.sh_size)) {
+                ok = false;
+                break;
+            }
+            sections.push_back(std::move(loaded));
+        }
+
+        if (section.sh_type == SHT_SYMTAB && section.sh_link < headers.size()) {
+            const Elf32_Shdr& strtab = headers[section.sh_link];
+            std::vector<Elf32_Sym> entries(section.sh_size / sizeof(Elf32_Sym));
+            std::vector<char> names(strtab.sh_size + 1, '\0');
+            if (!read_at(file, section.sh_offset, entries.data(), entries.size() * sizeof(Elf32_Sym)) ||
+                !read_at(file, strtab.sh_offset, names.data(), strtab.sh_size)) {
+                ok = false;
+                break;
+            }
+            for (const Elf32_Sym& entry : entries) {
+                if (entry.st_name && entry.st_name < strtab.sh_size) {
+                    symbols[names.data() + entry.st_name] = Symbol{entry.st_value, entry.st_size};
+                }
+            }
+        }
+    }
+
+    std::fclose(file);
+    if (!ok) {
+        error = std::string("truncated ELF ") + path;
+    }
+    return ok;
+}
+
+const uint8_t* ElfImage::at(uint32_t address, uint32_t size) const {
+    for (const Section& section : sections) {
+        uint64_t offset = (uint64_t)address - section.address;
+        if (address >= section.address && offset + size <= section.data.size()) {
+            return section.data.data() + offset;
+        }
+    }
+    return nullptr;
+}
+
+bool ElfImage::read_word(uint32_t address, uint32_t& value) const {
+    const uint8_t* bytes = at(address, 4);
+    if (!bytes) return false;
+    value = load_le32(bytes);
+    return true;
+}
+
+const char* ElfImage::string_at(uint32_t address) const {
+    for (const Section& section : sections) {
+        if (address < section.address || address - section.address >= section.data.size()) {
+            continue;
+        }
+        const uint8_t* start = section.data.data() + (address - section.address);
+        const uint8_t* end = section.data.data() + section.data.size();
+        return std::memchr(start, '\0', end - start) ? (const char*)start : nullptr;
+    }
+    return nullptr;
+}
+
+bool ElfImage::symbol(const char* name, uint32_t& address, uint32_t& size) const {
+    auto it = symbols.find(name);
+    if (it == symbols.end()) return false;
+    address = it->second.address;
+    size = it->second.size;
+    return true;
+}
+
+uint32_t ProbeHistogram::bucket_of(uint32_t cycles) {
+    if (cycles < (1u << (SUB_BUCKET_BITS + 1))) {
+        return cycles;
+    }
+    uint32_t msb = 31 - __builtin_clz(cycles);
+    uint32_t shift = msb - SUB_BUCKET_BITS;
+    uint32_t sub = (cycles >> shift) & ((1u << SUB_BUCKET_BITS) - 1);
+    return ((msb - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) | sub;
+}
+
+uint32_t ProbeHistogram::bucket_upper(uint32_t bucket) {
+    if (bucket < (1u << (SUB_BUCKET_BITS + 1))) {
+        return bucket;
+    }
+    uint32_t msb = (bucket >> SUB_BUCKET_BITS) + SUB_BUCKET_BITS - 1;
+    uint32_t shift = msb - SUB_BUCKET_BITS;
+    uint32_t sub = bucket & ((1u << SUB_BUCKET_BITS) - 1);
+    uint32_t lower = (1u << msb) | (sub << shift);
+    return lower + ((1u << shift) - 1);
+}
+
+void ProbeHistogram::add(uint32_t cycles) {
+    count++;
+    total += cycles;
+    if (cycles < min) min = cycles;
+    if (cycles > max) max = cycles;
+    buckets[bucket_of(cycles)]++;
+}
+
+uint32_t ProbeHistogram::percentile(uint32_t percent) const {
+    if (!count) return 0;
+
+    uint64_t rank = (count * percent + 99) / 100;
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (uint32_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        seen += buckets[bucket];
+        if (seen >= rank) {
+            uint32_t upper = bucket_upper(bucket);
+            return upper < max ? upper : max;
+        }
+    }
+    return max;
+}
+
+TraceDecoder::TraceDecoder(const ElfImage& elf, const TraceDecoderOptions& options)
+    : elf(elf), options(options) {}
+
+bool TraceDecoder::init(std::string& error) {
+    uint32_t stop = 0;
+    uint32_t size = 0;
+    if (!elf.symbol("__start_binlog_sites", sites_address, size) ||
+        !elf.symbol("__stop_binlog_sites", stop, size) || stop < sites_address) {
+        error = "ELF has no binlog_sites table (built before binary logging?)";
+        return false;
+    }
+    site_total = (stop - sites_address) / 4;
+    return true;
+}
+
+const char* TraceDecoder::resolve_string(uint32_t address, void* context) {
+    return static_cast<const TraceDecoder*>(context)->elf.string_at(address);
+}
+
+// Records carry the low word of mcycle; extend it per hart by the signed
+// distance from the previous stamp, which also copes with probe samples
+// stamped at their (earlier) start
+uint64_t TraceDecoder::extend_time(uint32_t hart, uint32_t low) {
+    auto it = hart_time.find(hart);
+    if (it == hart_time.end()) {
+        hart_time[hart] = low;
+        return low;
+    }
+    int64_t extended = (int64_t)it->second + (int32_t)(low - (uint32_t)it->second);
+    it->second = extended < 0 ? 0 : (uint64_t)extended;
+    return it->second;
+}
+
+ProbeHistogram& TraceDecoder::probe_at(uint32_t address) {
+    auto it = probes.find(address);
+    if (it != probes.end()) return it->second;
+
+    ProbeHistogram& probe = probes[address];
+    uint32_t name_address = 0;
+    const char* name = elf.read_word(address + PROBE_NAME_OFFSET, name_address)
+                           ? elf.string_at(name_address) : nullptr;
+    char fallback[32];
+    if (!name) {
+        std::snprintf(fallback, sizeof(fallback), "probe@0x%08" PRIx32, address);
+        name = fallback;
+    }
+    probe.name = name;
+    return probe;
+}
+
+static std::string json_escape(const char* text) {
+    std::string escaped;
+    for (; *text; text++) {
+        unsigned char c = (unsigned char)*text;
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += (char)c;
+        } else if (c < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        } else {
+            escaped += (char)c;
+        }
+    }
+    return escaped;
+}
+
+void TraceDecoder::chrome_event(const char* json) {
+    if (!options.chrome) return;
+    std::fputs(chrome_started ? ",\n" : "{\"traceEvents\":[\n", options.chrome);
+    std::fputs(json, options.chrome);
+    chrome_started = true;
+}
+
+void TraceDecoder::record(uint32_t hart, const uint32_t* words) {
+    uint32_t header = words[0];
+    uint32_t arg_count = LogRecord::arg_count_of(header);
+    uint32_t site = LogRecord::site_of(header);
+    const uint32_t* args = words + LogRecord::HEADER_WORDS;
+    bool new_hart = options.chrome && !hart_time.count(hart);
+    double ts = extend_time(hart, words[1]) / options.cycles_per_us;
+    char json[512];
+
+    if (new_hart) {
+        std::snprintf(json, sizeof(json),
+                      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%" PRIu32
+                      ",\"args\":{\"name\":\"hart %" PRIu32 "\"}}", hart, hart);
+        chrome_event(json);
+    }
+
+    if (site == LogRecord::PROBE_SITE && arg_count == 2) {
+        ProbeHistogram& probe = probe_at(args[0]);
+        probe.add(args[1]);
+        stats.probe_samples++;
+        std::snprintf(json, sizeof(json),
+                      "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%" PRIu32 "}",
+                      json_escape(probe.name.c_str()).c_str(), ts, args[1] / options.cycles_per_us, hart);
+        chrome_event(json);
+        return;
+    }
+
+    stats.records++;
+    const char* format = "<bad log site %u>\n";
+    uint32_t site_word = 0;
+    uint32_t bad_site_args[1] = {site};
+    if (site < site_total && elf.read_word(sites_address + 4 * site, site_word) &&
+        elf.string_at(site_word)) {
+        format = elf.string_at(site_word);
+    } else {
+        stats.bad_sites++;
+        args = bad_site_args;
+        arg_count = 1;
+    }
+
+    char line[256];
+    size_t len = LogFormatter::format(line, sizeof(line), format, args, arg_count,
+                                      resolve_string, this);
+    if (options.text) {
+        std::fwrite(line, 1, len, options.text);
+    }
+    if (options.chrome) {
+        // Instant event named after the line, without its trailing newline
+        while (len && (line[len - 1] == '\n' || line[len - 1] == ' ')) {
+            line[--len] = '\0';
+        }
+        std::snprintf(json, sizeof(json),
+                      "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":0,\"tid\":%" PRIu32 "}",
+                      json_escape(line).c_str(), ts, hart);
+        chrome_event(json);
+    }
+}
+
+size_t TraceDecoder::scan(const uint8_t* data, size_t size, bool at_end) {
+    size_t pos = 0;
+    size_t text_start = 0;
+
+    while (pos < size) {
+        size_t left = size - pos;
+        if (left < 4 + 4 * LogRecord::HEADER_WORDS) {
+            // Too short for a frame: text, unless more data may complete one
+            if (!at_end) break;
+            pos = size;
+            continue;
+        }
+
+        uint32_t sync = load_le32(data + pos);
+        uint32_t header = load_le32(data + pos + 4);
+        uint32_t arg_count = LogRecord::arg_count_of(header);
+        if ((sync & LogRecord::FRAME_SYNC_MASK) != LogRecord::FRAME_SYNC ||
+            arg_count > LogRecord::MAX_ARGS) {
+            pos++;
+            continue;
+        }
+        size_t frame_bytes = 4 * (1 + LogRecord::HEADER_WORDS + arg_count);
+        if (left < frame_bytes) {
+            if (!at_end) break;
+            pos++;
+            continue;
+        }
+
+        if (options.text && pos > text_start) {
+            std::fwrite(data + text_start, 1, pos - text_start, options.text);
+        }
+        stats.text_bytes += pos - text_start;
+
+        uint32_t words[LogRecord::MAX_WORDS];
+        for (uint32_t i = 0; i < LogRecord::HEADER_WORDS + arg_count; i++) {
+            words[i] = load_le32(data + pos + 4 + 4 * i);
+        }
+        record(sync & ~LogRecord::FRAME_SYNC_MASK, words);
+        pos += frame_bytes;
+        text_start = pos;
+    }
+
+    if (options.text && pos > text_start) {
+        std::fwrite(data + text_start, 1, pos - text_start, options.text);
+    }
+    stats.text_bytes += pos - text_start;
+    return pos;
+}
+
+bool TraceDecoder::decode_capture(FILE* in) {
+    // Room for a cut-off frame carried over in front of the next chunk
+    std::vector<uint8_t> buffer(CHUNK_BYTES + LogRecord::MAX_FRAME_BYTES);
+    size_t held = 0;
+
+    for (;;) {
+        size_t got = std::fread(buffer.data() + held, 1, CHUNK_BYTES, in);
+        bool at_end = got < CHUNK_BYTES;
+        held += got;
+
+        size_t used = scan(buffer.data(), held, at_end);
+        if (at_end) {
+            return !std::ferror(in);
+        }
+        held -= used;
+        std::memmove(buffer.data(), buffer.data() + used, held);
+    }
+}
+
+static bool read_target(FILE* dump, uint32_t dump_base, uint32_t address, void* out, size_t size) {
+    return address >= dump_base && read_at(dump, (uint64_t)address - dump_base, out, size);
+}
+
+bool TraceDecoder::decode_dump(FILE* dump, uint32_t dump_base, std::string& error) {
+    uint32_t address = 0;
+    uint32_t size = 0;
+    if (!elf.symbol(HARTS_SYMBOL, address, size) || size < sizeof(HartBufferImage)) {
+        error = "ELF has no BinLog::harts symbol";
+        return false;
+    }
+
+    HartBufferImage image;
+    for (uint32_t hart = 0; hart < size / sizeof(HartBufferImage); hart++) {
+        if (!read_target(dump, dump_base, address + hart * sizeof(HartBufferImage),
+                         &image, sizeof(image))) {
+            error = "dump does not cover BinLog::harts (wrong --dump-base?)";
+            return false;
+        }
+        stats.dropped += image.dropped;
+
+        // Only the records between head and tail are still whole; anything
+        // before head has been drained and may be partly overwritten
+        uint32_t pending = image.ring.tail - image.ring.head;
+        if (pending > LogRecord::RING_WORDS) {
+            error = "ring counters are corrupt";
+            return false;
+        }
+        uint32_t index = image.ring.head;
+        while (image.ring.tail - index >= LogRecord::HEADER_WORDS) {
+            uint32_t words[LogRecord::MAX_WORDS];
+            words[0] = image.ring.slots[index % LogRecord::RING_WORDS];
+            uint32_t record_words = LogRecord::HEADER_WORDS + LogRecord::arg_count_of(words[0]);
+            if (record_words > LogRecord::MAX_WORDS || image.ring.tail - index < record_words) {
+                break;
+            }
+            for (uint32_t i = 1; i < record_words; i++) {
+                words[i] = image.ring.slots[(index + i) % LogRecord::RING_WORDS];
+            }
+            record(hart, words);
+            index += record_words;
+        }
+    }
+
+    load_probe_table(dump, dump_base);
+    return true;
+}
+
+// The firmware's own histograms cover every sample since the last reset,
+// not just the ones still in the rings, so they replace what was decoded
+void TraceDecoder::load_probe_table(FILE* dump, uint32_t dump_base) {
+    uint32_t table = 0;
+    uint32_t table_size = 0;
+    uint32_t total_address = 0;
+    uint32_t total = 0;
+    uint32_t size = 0;
+    if (!elf.symbol(PROBES_SYMBOL, table, table_size) ||
+        !elf.symbol(PROBE_TOTAL_SYMBOL, total_address, size) ||
+        !read_target(dump, dump_base, total_address, &total, 4)) {
+        return;
+    }
+    if (total > table_size / 4) {
+        total = table_size / 4;
+    }
+
+    for (uint32_t id = 0; id < total; id++) {
+        uint32_t probe_address = 0;
+        uint8_t probe[PROBE_BYTES];
+        if (!read_target(dump, dump_base, table + 4 * id, &probe_address, 4) ||
+            !read_target(dump, dump_base, probe_address, probe, sizeof(probe))) {
+            continue;
+        }
+
+        ProbeHistogram histogram;
+        const char* name = elf.string_at(load_le32(probe + PROBE_NAME_OFFSET));
+        histogram.name = name ? name : probe_at(probe_address).name;
+        histogram.count = load_le32(probe + PROBE_COUNT_OFFSET);
+        histogram.min = load_le32(probe + PROBE_MIN_OFFSET);
+        histogram.max = load_le32(probe + PROBE_MAX_OFFSET);
+        histogram.total = load_le32(probe + PROBE_TOTAL_OFFSET) |
+                          (uint64_t)load_le32(probe + PROBE_TOTAL_OFFSET + 4) << 32;
+        for (uint32_t bucket = 0; bucket < ProbeHistogram::BUCKET_COUNT; bucket++) {
+            histogram.buckets[bucket] = load_le32(probe + PROBE_BUCKETS_OFFSET + 4 * bucket);
+        }
+        probes[probe_address] = histogram;
+    }
+}
+
+void TraceDecoder::finish() {
+    if (!options.chrome) return;
+    std::fputs(chrome_started ? "\n" : "{\"traceEvents\":[\n", options.chrome);
+    std::fputs("]}\n", options.chrome);
+    chrome_started = false;
+}
+
+void TraceDecoder::print_histograms(FILE* out) const {
+    std::fprintf(out, "%-24s %10s %10s %10s %10s %10s %10s %10s\n",
+                 "probe", "count", "min", "mean", "p50", "p90", "p99", "max");
+    for (const auto& entry : probes) {
+        const ProbeHistogram& probe = entry.second;
+        if (!probe.count) {
+            std::fprintf(out, "%-24s %10u\n", probe.name.c_str(), 0u);
+            continue;
+        }
+        std::fprintf(out, "%-24s %10" PRIu64 " %10" PRIu32 " %10" PRIu64 " %10" PRIu32
+                     " %10" PRIu32 " %10" PRIu32 " %10" PRIu32 "\n",
+                     probe.name.c_str(), probe.count, probe.min, probe.total / probe.count,
+                     probe.percentile(50), probe.percentile(90), probe.percentile(99), probe.max);
+
+        // Histogram bars for the occupied buckets, scaled to the fullest
+        uint64_t peak = 0;
+        for (uint64_t samples : probe.buckets) {
+            if (samples > peak) peak = samples;
+        }
+        for (uint32_t bucket = 0; bucket < ProbeHistogram::BUCKET_COUNT; bucket++) {
+            if (!probe.buckets[bucket]) continue;
+            int width = (int)((probe.buckets[bucket] * 40 + peak - 1) / peak);
+            std::fprintf(out, "    <= %10" PRIu32 " %10" PRIu64 " %.*s\n",
+                         ProbeHistogram::bucket_upper(bucket), probe.buckets[bucket], width,
+                         "########################################");
+        }
+    }
+}
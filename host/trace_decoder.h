@@ -0,0 +1,138 @@
+#pragma once
+
+// Host-side decoding of the firmware's binary log (include/lib/log_format.h)
+//
+// Log records carry a site ID and raw argument words, never text; the
+// format strings, profiler probe names and %s strings are read back out of
+// the firmware ELF. Records come either from a UART capture of a
+// LOG_RAW=1 build, where frames are mixed with plain console text, or
+// from a raw memory dump that contains the per-hart rings. A capture is
+// processed in fixed-size chunks and a dump is only read where the rings
+// and probes live, so input size is bounded by the disk, not by memory.
+
+#include "log_format.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+// Allocated sections and symbols of an ELF32 little-endian image; debug
+// sections are never read
+class ElfImage {
+public:
+    bool load(const char* path, std::string& error);
+
+    // Bytes at a target address, nullptr unless all size bytes lie in one
+    // section with file contents (.bss has none)
+    const uint8_t* at(uint32_t address, uint32_t size) const;
+    bool read_word(uint32_t address, uint32_t& value) const;
+
+    // NUL-terminated string at a target address, nullptr if the string
+    // doesn't end inside its section
+    const char* string_at(uint32_t address) const;
+
+    bool symbol(const char* name, uint32_t& address, uint32_t& size) const;
+
+private:
+    struct Section {
+        uint32_t address;
+        std::vector<uint8_t> data;
+    };
+
+    struct Symbol {
+        uint32_t address;
+        uint32_t size;
+    };
+
+    std::vector<Section> sections;
+    std::map<std::string, Symbol> symbols;
+};
+
+// Cycle histogram per profiler probe, in the firmware's log-linear buckets
+// (lib/profiler.h): exact below 8 cycles, four sub-buckets per power of two
+struct ProbeHistogram {
+    static constexpr uint32_t SUB_BUCKET_BITS = 2;
+    static constexpr uint32_t BUCKET_COUNT = (32 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+    std::string name;
+    uint64_t count = 0;
+    uint32_t min = 0xFFFFFFFF;
+    uint32_t max = 0;
+    uint64_t total = 0;
+    uint64_t buckets[BUCKET_COUNT] = {};
+
+    void add(uint32_t cycles);
+
+    // Upper bound of the bucket holding the given percentile (1-100),
+    // clamped to the observed maximum
+    uint32_t percentile(uint32_t percent) const;
+
+    static uint32_t bucket_of(uint32_t cycles);
+    static uint32_t bucket_upper(uint32_t bucket);
+};
+
+struct TraceDecoderOptions {
+    FILE* text = nullptr;           // Reconstructed console output, or none
+    FILE* chrome = nullptr;         // Chrome trace JSON timeline, or none
+    double cycles_per_us = 1000.0;  // mcycle rate for the timeline
+};
+
+struct TraceDecoderStats {
+    uint64_t records = 0;
+    uint64_t probe_samples = 0;
+    uint64_t text_bytes = 0;
+    uint64_t bad_sites = 0;         // Site IDs outside the ELF's table
+    uint64_t dropped = 0;           // Ring-full drops, from a memory dump
+};
+
+class TraceDecoder {
+public:
+    static constexpr size_t CHUNK_BYTES = 1 << 20;
+
+    TraceDecoder(const ElfImage& elf, const TraceDecoderOptions& options);
+
+    // Locate the binlog_sites table; false if the ELF has none
+    bool init(std::string& error);
+
+    // Stream a UART capture from start to end of file
+    bool decode_capture(FILE* in);
+
+    // Decode capture bytes; returns how many were consumed. Unless at_end,
+    // a frame cut off by the end of data is left for the next call (with
+    // fewer than LogRecord::MAX_FRAME_BYTES bytes left over).
+    size_t scan(const uint8_t* data, size_t size, bool at_end);
+
+    // Decode the records still pending in the rings of a memory dump taken
+    // at dump_base, and load the profiler's probe table from it
+    bool decode_dump(FILE* dump, uint32_t dump_base, std::string& error);
+
+    // One record: header, timestamp and arguments
+    void record(uint32_t hart, const uint32_t* words);
+
+    // Close the timeline; call once after the input is done
+    void finish();
+
+    void print_histograms(FILE* out) const;
+
+    const TraceDecoderStats& get_stats() const { return stats; }
+    const std::map<uint32_t, ProbeHistogram>& histograms() const { return probes; }
+
+private:
+    const ElfImage& elf;
+    TraceDecoderOptions options;
+    TraceDecoderStats stats;
+    uint32_t sites_address = 0;
+    uint32_t site_total = 0;
+    std::map<uint32_t, ProbeHistogram> probes;     // By probe address
+    std::map<uint32_t, uint64_t> hart_time;        // Last extended mcycle per hart
+    bool chrome_started = false;
+
+    uint64_t extend_time(uint32_t hart, uint32_t low);
+    ProbeHistogram& probe_at(uint32_t address);
+    void chrome_event(const char* json);
+    void load_probe_table(FILE* dump, uint32_t dump_base);
+
+    static const char* resolve_string(uint32_t address, void* context);
+};
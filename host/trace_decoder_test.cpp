@@ -0,0 +1,376 @@
+// Host-side tests for the trace decoder (host/trace_decoder.cpp)
+//
+// Builds a small ELF32 image the way the firmware's linker script lays it
+// out: format strings in .rodata, a binlog_sites table bracketed by
+// __start/__stop symbols, a profiler probe in .data and the BinLog/Profiler
+// symbols a memory dump is read through. Then decodes a capture mixing
+// console text with raw frames, fed in awkwardly sized pieces, and a
+// memory dump whose rings wrap.
+
+#include "trace_decoder.h"
+#include "test_check.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <elf.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t RODATA = 0x80001000;
+constexpr uint32_t SITES = 0x80002000;
+constexpr uint32_t DATA = 0x84000000;
+constexpr uint32_t PROBE = DATA + 0x40;
+constexpr uint32_t HARTS = DATA + 0x10000;
+constexpr uint32_t PROBES = DATA + 0x30000;
+constexpr uint32_t PROBE_TOTAL = PROBES + 0x80;
+constexpr uint32_t DUMP_PROBE = PROBES + 0x100;
+constexpr uint32_t DUMP_BYTES = 0x31000;
+
+// LogHartBuffer as the firmware lays it out: ring tail, head, slots
+constexpr uint32_t RING_TAIL = 0;
+constexpr uint32_t RING_HEAD = 64;
+constexpr uint32_t RING_SLOTS = 128;
+
+const char* const strings[] = {"Value %u\n", "Name %s hex %08x\n", "alpha", "spin"};
+uint32_t string_address[4];
+const uint32_t BAD_SITE = 7;
+
+void put32(std::vector<uint8_t>& bytes, size_t offset, uint32_t value) {
+    if (bytes.size() < offset + 4) bytes.resize(offset + 4);
+    for (int i = 0; i < 4; i++) {
+        bytes[offset + i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+void append(std::vector<uint8_t>& bytes, const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    bytes.insert(bytes.end(), p, p + size);
+}
+
+// Write the test ELF to a temporary file and return its path
+std::string write_elf() {
+    std::vector<uint8_t> rodata;
+    for (int i = 0; i < 4; i++) {
+        string_address[i] = RODATA + (uint32_t)rodata.size();
+        append(rodata, strings[i], std::strlen(strings[i]) + 1);
+    }
+    std::vector<uint8_t> sites;
+    put32(sites, 0, string_address[0]);
+    put32(sites, 4, string_address[1]);
+    std::vector<uint8_t> data;
+    put32(data, PROBE - DATA, string_address[3]);
+
+    std::vector<uint8_t> strtab(1, 0);
+    std::vector<Elf32_Sym> symtab(1, Elf32_Sym{});
+    auto symbol = [&](const char* name, uint32_t value, uint32_t size) {
+        Elf32_Sym sym = {};
+        sym.st_name = (uint32_t)strtab.size();
+        sym.st_value = value;
+        sym.st_size = size;
+        append(strtab, name, std::strlen(name) + 1);
+        symtab.push_back(sym);
+    };
+    symbol("__start_binlog_sites", SITES, 0);
+    symbol("__stop_binlog_sites", SITES + (uint32_t)sites.size(), 0);
+    symbol("_ZN6BinLog5hartsE", HARTS, 2 * sizeof(LogHartBuffer));
+    symbol("_ZN8Profiler6probesE", PROBES, 32 * 4);
+    symbol("_ZN8Profiler11probe_totalE", PROBE_TOTAL, 4);
+
+    std::vector<uint8_t> image(sizeof(Elf32_Ehdr), 0);
+    std::vector<Elf32_Shdr> headers(1, Elf32_Shdr{});
+    auto section = [&](uint32_t type, uint32_t flags, uint32_t address,
+                       const void* contents, size_t size, uint32_t link) {
+        Elf32_Shdr header = {};
+        header.sh_type = type;
+        header.sh_flags = flags;
+        header.sh_addr = address;
+        header.sh_offset = (uint32_t)image.size();
+        header.sh_size = (uint32_t)size;
+        header.sh_link = link;
+        append(image, contents, size);
+        headers.push_back(header);
+    };
+    section(SHT_PROGBITS, SHF_ALLOC, RODATA, rodata.data(), rodata.size(), 0);
+    section(SHT_PROGBITS, SHF_ALLOC, SITES, sites.data(), sites.size(), 0);
+    section(SHT_PROGBITS, SHF_ALLOC | SHF_WRITE, DATA, data.data(), data.size(), 0);
+    section(SHT_SYMTAB, 0, 0, symtab.data(), symtab.size() * sizeof(Elf32_Sym), 5);
+    section(SHT_STRTAB, 0, 0, strtab.data(), strtab.size(), 0);
+
+    Elf32_Ehdr header = {};
+    std::memcpy(header.e_ident, ELFMAG, SELFMAG);
+    header.e_ident[EI_CLASS] = ELFCLASS32;
+    header.e_ident[EI_DATA] = ELFDATA2LSB;
+    header.e_ident[EI_VERSION] = EV_CURRENT;
+    header.e_type = ET_EXEC;
+    header.e_machine = EM_RISCV;
+    header.e_ehsize = sizeof(Elf32_Ehdr);
+    header.e_shentsize = sizeof(Elf32_Shdr);
+    header.e_shnum = (uint16_t)headers.size();
+    header.e_shoff = (uint32_t)image.size();
+    append(image, headers.data(), headers.size() * sizeof(Elf32_Shdr));
+    std::memcpy(image.data(), &header, sizeof(header));
+
+    char path[] = "/tmp/trace_decoder_test_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0 || write(fd, image.data(), image.size()) != (ssize_t)image.size()) {
+        std::printf("FAIL cannot write %s\n", path);
+        std::exit(1);
+    }
+    close(fd);
+    return path;
+}
+
+void frame(std::vector<uint8_t>& bytes, uint32_t hart, uint32_t site, uint32_t timestamp,
+           std::vector<uint32_t> args) {
+    size_t at = bytes.size();
+    put32(bytes, at, LogRecord::FRAME_SYNC | hart);
+    put32(bytes, at + 4, LogRecord::header(site, (uint32_t)args.size()));
+    put32(bytes, at + 8, timestamp);
+    for (size_t i = 0; i < args.size(); i++) {
+        put32(bytes, at + 12 + 4 * i, args[i]);
+    }
+}
+
+void text(std::vector<uint8_t>& bytes, const char* str) {
+    append(bytes, str, std::strlen(str));
+}
+
+std::vector<uint8_t> make_capture() {
+    std::vector<uint8_t> bytes;
+    text(bytes, "boot\n");
+    frame(bytes, 0, 0, 100, {42});
+    text(bytes, "mid\n");
+    frame(bytes, 1, 1, 200, {string_address[2], 0xBEEF});
+    for (uint32_t cycles = 1; cycles <= 100; cycles++) {
+        frame(bytes, 0, LogRecord::PROBE_SITE, 1000 + 200 * cycles, {PROBE, cycles});
+    }
+    frame(bytes, 0, BAD_SITE, 30000, {});
+    // Sync-like bytes with an impossible argument count are console text
+    put32(bytes, bytes.size(), LogRecord::FRAME_SYNC);
+    put32(bytes, bytes.size(), LogRecord::header(0, 0xFF));
+    text(bytes, "end\n");
+    return bytes;
+}
+
+const char EXPECTED_LINES[] = "boot\nValue 42\nmid\nName alpha hex 0000beef\n<bad log site 7>\n";
+
+// Feed the capture in pieces of the given size, carrying unconsumed bytes
+// over the way decode_capture() does
+std::string decode_in_pieces(const ElfImage& elf, const std::vector<uint8_t>& capture,
+                             size_t piece, TraceDecoder** keep) {
+    char* out = nullptr;
+    size_t out_size = 0;
+    FILE* stream = open_memstream(&out, &out_size);
+    TraceDecoderOptions options;
+    options.text = stream;
+    TraceDecoder* decoder = new TraceDecoder(elf, options);
+    std::string error;
+    CHECK(decoder->init(error));
+
+    std::vector<uint8_t> buffer;
+    for (size_t at = 0; at < capture.size(); at += piece) {
+        size_t size = std::min(piece, capture.size() - at);
+        buffer.insert(buffer.end(), capture.begin() + at, capture.begin() + at + size);
+        bool at_end = at + size == capture.size();
+        size_t used = decoder->scan(buffer.data(), buffer.size(), at_end);
+        CHECK(at_end ? used == buffer.size() : buffer.size() - used < LogRecord::MAX_FRAME_BYTES);
+        buffer.erase(buffer.begin(), buffer.begin() + used);
+    }
+    std::fclose(stream);
+    std::string result(out, out_size);
+    std::free(out);
+
+    if (keep) {
+        *keep = decoder;
+    } else {
+        delete decoder;
+    }
+    return result;
+}
+
+void test_capture(const ElfImage& elf) {
+    int failed_before = failures;
+    std::vector<uint8_t> capture = make_capture();
+    std::string expected = EXPECTED_LINES;
+    expected.append((const char*)capture.data() + capture.size() - 12, 12);
+
+    const size_t pieces[] = {1, 3, 7, 13, 40, capture.size()};
+    for (size_t piece : pieces) {
+        TraceDecoder* decoder = nullptr;
+        std::string result = decode_in_pieces(elf, capture, piece, &decoder);
+        CHECK(result == expected);
+
+        const TraceDecoderStats& stats = decoder->get_stats();
+        CHECK(stats.records == 3);
+        CHECK(stats.bad_sites == 1);
+        CHECK(stats.probe_samples == 100);
+        CHECK(stats.text_bytes == std::strlen("boot\nmid\n") + 12);
+
+        CHECK(decoder->histograms().size() == 1);
+        const ProbeHistogram& probe = decoder->histograms().begin()->second;
+        CHECK(decoder->histograms().begin()->first == PROBE);
+        CHECK(probe.name == "spin");
+        CHECK(probe.count == 100);
+        CHECK(probe.min == 1 && probe.max == 100);
+        CHECK(probe.total == 5050);
+        CHECK(probe.percentile(1) == 1);
+        CHECK(probe.percentile(100) == 100);
+        // 50th sample is 50, in the bucket [48, 55]
+        CHECK(probe.percentile(50) == 55);
+        delete decoder;
+    }
+
+    // A frame cut off by the end of the capture is left as text
+    std::vector<uint8_t> cut(capture.begin(), capture.begin() + 5 + 10);
+    std::string result = decode_in_pieces(elf, cut, cut.size(), nullptr);
+    CHECK(result.size() == cut.size() && std::memcmp(result.data(), cut.data(), cut.size()) == 0);
+    report("capture", failed_before);
+}
+
+void test_capture_file_and_chrome(const ElfImage& elf) {
+    int failed_before = failures;
+    std::vector<uint8_t> capture = make_capture();
+    FILE* in = std::tmpfile();
+    std::fwrite(capture.data(), 1, capture.size(), in);
+    std::rewind(in);
+
+    char* json = nullptr;
+    size_t json_size = 0;
+    TraceDecoderOptions options;
+    options.chrome = open_memstream(&json, &json_size);
+    options.cycles_per_us = 100.0;
+    TraceDecoder decoder(elf, options);
+    std::string error;
+    CHECK(decoder.init(error));
+    CHECK(decoder.decode_capture(in));
+    decoder.finish();
+    std::fclose(options.chrome);
+    std::fclose(in);
+
+    std::string trace(json, json_size);
+    std::free(json);
+    CHECK(trace.rfind("{\"traceEvents\":[\n", 0) == 0);
+    CHECK(trace.size() > 3 && trace.compare(trace.size() - 3, 3, "]}\n") == 0);
+    CHECK(trace.find("\"name\":\"hart 0\"") != std::string::npos);
+    CHECK(trace.find("\"name\":\"hart 1\"") != std::string::npos);
+    CHECK(trace.find("{\"name\":\"Value 42\",\"ph\":\"i\",\"s\":\"t\",\"ts\":1.000,") != std::string::npos);
+    // Last probe sample: started at 21000 cycles, ran 100
+    CHECK(trace.find("{\"name\":\"spin\",\"ph\":\"X\",\"ts\":210.000,\"dur\":1.000,\"pid\":0,\"tid\":0}")
+          != std::string::npos);
+    CHECK(decoder.get_stats().probe_samples == 100);
+    report("capture file + chrome", failed_before);
+}
+
+void test_dump(const ElfImage& elf) {
+    int failed_before = failures;
+    std::vector<uint8_t> dump(DUMP_BYTES, 0);
+    const uint32_t written_offset = (uint32_t)offsetof(LogHartBuffer, written);
+
+    // Hart 0: one drained record before head, two pending
+    uint32_t hart0 = HARTS - DATA;
+    uint32_t records0[] = {LogRecord::header(0, 1), 10, 6,
+                           LogRecord::header(0, 1), 20, 7,
+                           LogRecord::header(0, 1), 30, 8};
+    for (uint32_t i = 0; i < 9; i++) {
+        put32(dump, hart0 + RING_SLOTS + 4 * i, records0[i]);
+    }
+    put32(dump, hart0 + RING_HEAD, 3);
+    put32(dump, hart0 + RING_TAIL, 9);
+    put32(dump, hart0 + written_offset, 3);
+    put32(dump, hart0 + written_offset + 4, 2);
+
+    // Hart 1: a record wrapping around the end of the ring
+    uint32_t hart1 = hart0 + sizeof(LogHartBuffer);
+    uint32_t head = 0xFFFFFFFF - 1;
+    uint32_t records1[] = {LogRecord::header(1, 2), 40, string_address[2], 0x12};
+    for (uint32_t i = 0; i < 4; i++) {
+        put32(dump, hart1 + RING_SLOTS + 4 * ((head + i) % LogRecord::RING_WORDS), records1[i]);
+    }
+    put32(dump, hart1 + RING_HEAD, head);
+    put32(dump, hart1 + RING_TAIL, head + 4);
+
+    // Probe table with one probe: 5, 7 and 9 cycles
+    put32(dump, PROBE_TOTAL - DATA, 1);
+    put32(dump, PROBES - DATA, DUMP_PROBE);
+    uint32_t probe = DUMP_PROBE - DATA;
+    put32(dump, probe + 0, string_address[3]);
+    put32(dump, probe + 8, 3);
+    put32(dump, probe + 12, 5);
+    put32(dump, probe + 16, 9);
+    put32(dump, probe + 24, 21);
+    for (uint32_t cycles : {5u, 7u, 9u}) {
+        uint32_t bucket = ProbeHistogram::bucket_of(cycles);
+        put32(dump, probe + 48 + 4 * bucket, 1);
+    }
+
+    FILE* in = std::tmpfile();
+    std::fwrite(dump.data(), 1, dump.size(), in);
+
+    char* out = nullptr;
+    size_t out_size = 0;
+    TraceDecoderOptions options;
+    options.text = open_memstream(&out, &out_size);
+    TraceDecoder decoder(elf, options);
+    std::string error;
+    CHECK(decoder.init(error));
+    CHECK(decoder.decode_dump(in, DATA, error));
+    std::fclose(options.text);
+
+    CHECK(std::string(out, out_size) == "Value 7\nValue 8\nName alpha hex 00000012\n");
+    std::free(out);
+    CHECK(decoder.get_stats().records == 3);
+    CHECK(decoder.get_stats().dropped == 2);
+
+    CHECK(decoder.histograms().size() == 1);
+    const ProbeHistogram& histogram = decoder.histograms().begin()->second;
+    CHECK(histogram.name == "spin");
+    CHECK(histogram.count == 3 && histogram.min == 5 && histogram.max == 9);
+    CHECK(histogram.total == 21);
+    CHECK(histogram.percentile(100) == 9);
+
+    // A base past the rings means the dump doesn't cover them
+    TraceDecoder wrong_base(elf, TraceDecoderOptions());
+    CHECK(wrong_base.init(error));
+    CHECK(!wrong_base.decode_dump(in, HARTS + 4, error));
+    std::fclose(in);
+    report("memory dump", failed_before);
+}
+
+}  // namespace
+
+int main() {
+    std::string path = write_elf();
+    ElfImage elf;
+    std::string error;
+    bool loaded = elf.load(path.c_str(), error);
+    unlink(path.c_str());
+    CHECK(loaded);
+    if (!loaded) {
+        std::printf("  %s\n", error.c_str());
+        return 1;
+    }
+
+    uint32_t word = 0;
+    CHECK(elf.read_word(SITES + 4, word) && word == string_address[1]);
+    CHECK(elf.string_at(string_address[2]) && std::strcmp(elf.string_at(string_address[2]), "alpha") == 0);
+    CHECK(!elf.at(SITES + 8, 4));
+
+    ElfImage empty;
+    CHECK(!empty.load("/nonexistent/riscv-program.elf", error));
+
+    test_capture(elf);
+    test_capture_file_and_chrome(elf);
+    test_dump(elf);
+
+    if (failures) {
+        std::printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("all trace decoder tests passed\n");
+    return 0;
+}
@@ -0,0 +1,110 @@
+// Host-side multi-thread stress test for WorkStealingDeque
+//
+// The owner thread pushes a numbered stream, popping some of it back
+// itself, while several thief threads steal concurrently. Every item must
+// be taken exactly once: a broken last-item race shows up as a duplicate,
+// a lost update of top or bottom as a missing item. (TSan does not model
+// the fences and flags the thief's speculative slot copy, which is only
+// trusted after its CAS, so it is of limited use here.)
+
+#include "work_deque.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t ITEMS = 2000000;
+constexpr int THIEVES = 3;
+
+struct Item {
+    uint32_t sequence;
+    uint32_t check;
+};
+
+uint32_t check_of(uint32_t sequence) {
+    return sequence * 2654435761u ^ 0x5bd1e995u;
+}
+
+template<uint32_t Capacity>
+bool stress(const char* name) {
+    static WorkStealingDeque<Item, Capacity> deque;
+    std::vector<std::atomic<uint8_t>> taken(ITEMS);
+    std::atomic<uint32_t> errors{0};
+    std::atomic<uint32_t> stolen{0};
+    std::atomic<bool> done{false};
+
+    auto take = [&](const Item& item) {
+        if (item.sequence >= ITEMS || item.check != check_of(item.sequence) ||
+            taken[item.sequence].fetch_add(1, std::memory_order_relaxed) != 0) {
+            errors++;
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < THIEVES; ++i) {
+        thieves.emplace_back([&] {
+            Item item;
+            uint32_t count = 0;
+            while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+                if (deque.steal(item)) {
+                    take(item);
+                    count++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            stolen += count;
+        });
+    }
+
+    // Owner: push in bursts, pop back part of each burst (LIFO end)
+    uint32_t next = 0;
+    Item item;
+    while (next < ITEMS) {
+        uint32_t burst = (next % 13) + 1;
+        for (uint32_t i = 0; i < burst && next < ITEMS; ++i) {
+            Item pushed = {next, check_of(next)};
+            if (deque.push(pushed)) {
+                next++;
+            } else if (deque.pop(item)) {
+                take(item);
+            }
+        }
+        for (uint32_t i = 0; i < burst / 2; ++i) {
+            if (deque.pop(item)) take(item);
+        }
+    }
+    while (deque.pop(item)) {
+        take(item);
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread& thief : thieves) {
+        thief.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint32_t missing = 0;
+    for (auto& flag : taken) {
+        if (flag.load(std::memory_order_relaxed) != 1) missing++;
+    }
+    bool ok = errors == 0 && missing == 0 && deque.empty();
+    printf("%-12s capacity=%-5u items=%u stolen=%u Mitems/s=%.1f errors=%u missing=%u %s\n",
+           name, Capacity, ITEMS, stolen.load(), ITEMS / seconds / 1e6, errors.load(), missing,
+           ok ? "ok" : "FAILED");
+    return ok;
+}
+
+}
+
+int main() {
+    bool ok = true;
+    ok &= stress<2>("tiny_deque");
+    ok &= stress<16>("small_deque");
+    ok &= stress<256>("large_deque");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "cstdint"
+
+// Benchmark body: one timed iteration
+typedef void (*BenchFunction)();
+
+// Cycle statistics for one benchmark, overhead-corrected
+struct BenchStats {
+    uint32_t iterations;
+    uint32_t min;
+    uint32_t median;
+    uint32_t mean;
+    uint32_t p99;
+    uint32_t max;
+};
+
+// On-target micro-benchmark registered at static-init time
+//
+// Each benchmark runs `warmup` untimed iterations, then `iterations` timed
+// ones; every iteration is bracketed by mcycle reads and the fixed cost of
+// the bracketing (measured once on an empty body) is subtracted. Results
+// are printed as one machine-readable line per benchmark:
+//
+//   BENCH name=<name> iters=<n> min=<c> median=<c> mean=<c> p99=<c> max=<c> ops=<n> bytes=<n>
+//         ops_per_kcycle=<n>
+//
+// Cycle values are per iteration; ops and bytes say how much work one
+// iteration does, so cycles/op and bytes/cycle can be derived offline.
+// ops_per_kcycle is ops per 1000 median cycles (elements per kilocycle
+// for array kernels), precomputed since the UART prints integers only.
+class Benchmark {
+public:
+    static constexpr uint32_t DEFAULT_WARMUP = 4;
+    static constexpr uint32_t DEFAULT_ITERATIONS = 64;
+    static constexpr uint32_t MAX_ITERATIONS = 256;
+
+    Benchmark(const char* name, BenchFunction function, uint32_t ops_per_iteration,
+              uint32_t bytes_per_iteration, uint32_t iterations = DEFAULT_ITERATIONS);
+
+    const char* name() const { return name_; }
+    Benchmark* next() const { return next_; }
+    static Benchmark* first() { return head; }
+
+    BenchStats run() const;
+
+    // Run every registered benchmark in registration order and print its
+    // result line; returns how many ran
+    static uint32_t run_all();
+
+    // Cycles spent timing an empty iteration (min of several runs)
+    static uint32_t overhead();
+
+private:
+    const char* name_;
+    BenchFunction function;
+    uint32_t ops_per_iteration;
+    uint32_t bytes_per_iteration;
+    uint32_t iterations;
+    Benchmark* next_;
+
+    static Benchmark* head;
+    static Benchmark* tail;
+    static uint32_t overhead_cycles;
+
+    void print(const BenchStats& stats) const;
+};
+
+// Keep the compiler from discarding a value or a store to memory
+template<typename T>
+inline void bench_keep(const T& value) {
+    asm volatile ("" : : "r" (&value) : "memory");
+}
+
+inline void bench_clobber() {
+    asm volatile ("" : : : "memory");
+}
+
+// Define and register a benchmark:
+//   BENCHMARK(simple_map_insert_64, 64, 0) { ... one iteration ... }
+#define BENCHMARK_ITERATIONS(name, ops, bytes, iterations) \
+    static void bench_##name(); \
+    static Benchmark bench_registration_##name(#name, bench_##name, ops, bytes, iterations); \
+    static void bench_##name()
+
+#define BENCHMARK(name, ops, bytes) \
+    BENCHMARK_ITERATIONS(name, ops, bytes, Benchmark::DEFAULT_ITERATIONS)
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "cstdint"
+
+// Startup cost measured by _start (start.S), in mcycle from its first
+// instruction: copying .fast_text/.fast_data/.data to their run addresses
+// and clearing both BSS sections, then that plus the global constructors
+// (everything before main)
+struct BootTiming {
+    uint32_t section_init_cycles;
+    uint32_t to_main_cycles;
+};
+
+extern "C" {
+    extern const BootTiming boot_timing;
+}
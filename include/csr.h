@@ -0,0 +1,100 @@
+#pragma once
+
+#include "cstdint"
+
+// RISC-V CSR numbers
+#define CSR_MSTATUS     0x300
+#define CSR_MISA        0x301
+#define CSR_MIE         0x304
+#define CSR_MTVEC       0x305
+#define CSR_MCOUNTINHIBIT 0x320
+#define CSR_MHPMEVENT3  0x323
+#define CSR_MSCRATCH    0x340
+#define CSR_MEPC        0x341
+#define CSR_MCAUSE      0x342
+#define CSR_MTVAL       0x343
+#define CSR_MIP         0x344
+#define CSR_MCYCLE      0xB00
+#define CSR_MINSTRET    0xB02
+#define CSR_MHPMCOUNTER3 0xB03
+#define CSR_MCYCLEH     0xB80
+#define CSR_MINSTRETH   0xB82
+#define CSR_MHPMCOUNTER3H 0xB83
+#define CSR_MHARTID     0xF14
+
+// CSRs the csr<> template accepts; anything else is a compile error
+constexpr bool csr_is_supported(uint32_t number) {
+    return number == CSR_MSTATUS || number == CSR_MISA || number == CSR_MIE ||
+           number == CSR_MTVEC || number == CSR_MCOUNTINHIBIT || number == CSR_MHPMEVENT3 ||
+           number == CSR_MSCRATCH ||
+           number == CSR_MEPC || number == CSR_MCAUSE || number == CSR_MTVAL ||
+           number == CSR_MIP || number == CSR_MCYCLE || number == CSR_MINSTRET ||
+           number == CSR_MCYCLEH || number == CSR_MINSTRETH || number == CSR_MHPMCOUNTER3 ||
+           number == CSR_MHPMCOUNTER3H || number == CSR_MHARTID;
+}
+
+// CSR numbers 0xC00-0xFFF are read-only (csr[11:10] == 0b11)
+constexpr bool csr_is_writable(uint32_t number) {
+    return (number >> 10) != 3;
+}
+
+// Compile-time CSR access: csr<CSR_MIE>::set(MIE_MTIE) inlines to a single
+// csrs (csrsi for a 5-bit constant). The CSR number is an instruction
+// immediate, so it has to be known at compile time; unsupported CSRs and
+// writes to read-only CSRs are rejected by static_assert instead of being
+// silently ignored. Writes are compiler memory barriers, so critical
+// sections built on mstatus.MIE keep their ordering.
+template<uint32_t Number>
+struct csr {
+    static_assert(csr_is_supported(Number), "unsupported CSR");
+
+    static inline uint32_t read() {
+        uint32_t value;
+        asm volatile ("csrr %0, %1" : "=r" (value) : "i" (Number));
+        return value;
+    }
+
+    static inline void write(uint32_t value) {
+        static_assert(csr_is_writable(Number), "CSR is read-only");
+        asm volatile ("csrw %0, %1" : : "i" (Number), "rK" (value) : "memory");
+    }
+
+    static inline void set(uint32_t bits) {
+        static_assert(csr_is_writable(Number), "CSR is read-only");
+        asm volatile ("csrs %0, %1" : : "i" (Number), "rK" (bits) : "memory");
+    }
+
+    static inline void clear(uint32_t bits) {
+        static_assert(csr_is_writable(Number), "CSR is read-only");
+        asm volatile ("csrc %0, %1" : : "i" (Number), "rK" (bits) : "memory");
+    }
+
+    // Atomically set bits and return the previous value
+    static inline uint32_t read_set(uint32_t bits) {
+        static_assert(csr_is_writable(Number), "CSR is read-only");
+        uint32_t value;
+        asm volatile ("csrrs %0, %1, %2" : "=r" (value) : "i" (Number), "rK" (bits) : "memory");
+        return value;
+    }
+
+    // Atomically clear bits and return the previous value
+    static inline uint32_t read_clear(uint32_t bits) {
+        static_assert(csr_is_writable(Number), "CSR is read-only");
+        uint32_t value;
+        asm volatile ("csrrc %0, %1, %2" : "=r" (value) : "i" (Number), "rK" (bits) : "memory");
+        return value;
+    }
+};
+
+// Read a 64-bit counter split across a low/high CSR pair on RV32. The high
+// half is re-read to catch a carry out of the low half between the reads.
+template<uint32_t Low, uint32_t High>
+inline uint64_t csr_read64() {
+    uint32_t hi;
+    uint32_t lo;
+    do {
+        hi = csr<High>::read();
+        lo = csr<Low>::read();
+    } while (hi != csr<High>::read());
+    return ((uint64_t)hi << 32) | lo;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "cstdint"
+
+// Software timer callback; runs in machine timer interrupt context
+typedef void (*TimerCallback)(void* context);
+
+// Handle returned by schedule_*; 0 is never a valid timer
+typedef uint32_t TimerId;
+
+// Timer statistics
+struct TimerStats {
+    uint32_t interrupts;        // Machine timer interrupts taken
+    uint32_t fired;             // Callbacks run
+    uint32_t cancelled;         // Timers cancelled before expiry
+    uint32_t reprograms;        // mtimecmp writes
+    uint32_t schedule_failures; // schedule_* calls with no free slot
+};
+
+// Tickless timer driver for the QEMU virt CLINT
+//
+// Software timers are kept in a fixed-size min-heap ordered by deadline,
+// and mtimecmp is only ever programmed for the earliest one, so with no
+// timer due the core takes no timer interrupts at all and can sit in wfi.
+// Deadlines are absolute mtime values (64-bit, 10 MHz on QEMU virt);
+// mtime and mtimecmp are accessed as two 32-bit halves in the order the
+// privileged spec prescribes for RV32.
+//
+// schedule_*/cancel may be called from the main loop or from a timer
+// callback; they mask interrupts around the heap update.
+class ClintTimer {
+public:
+    static constexpr uint64_t TICKS_PER_SECOND = 10000000;
+    static constexpr uint32_t MAX_TIMERS = 32;
+
+    static constexpr uint64_t us_to_ticks(uint64_t us) { return us * (TICKS_PER_SECOND / 1000000); }
+    static constexpr uint64_t ms_to_ticks(uint64_t ms) { return ms * (TICKS_PER_SECOND / 1000); }
+
+    // Park mtimecmp and enable the machine timer interrupt
+    static void init();
+
+    // Current mtime
+    static uint64_t now();
+
+    // Run callback(context) once mtime reaches deadline. Returns 0 when all
+    // MAX_TIMERS slots are in use.
+    static TimerId schedule_at(uint64_t deadline, TimerCallback callback, void* context);
+    static TimerId schedule_after(uint64_t ticks, TimerCallback callback, void* context);
+
+    // Remove a pending timer; false if it already fired or was cancelled
+    static bool cancel(TimerId id);
+
+    // Timers still waiting to fire
+    static uint32_t pending() { return heap_size; }
+
+    // Deadline of the earliest timer, or UINT64_MAX when none is pending
+    static uint64_t next_deadline();
+
+    // Called from machine_timer_interrupt_handler
+    static void handle_interrupt();
+
+    static const TimerStats& get_stats() { return stats; }
+
+private:
+    struct Timer {
+        uint64_t deadline;
+        TimerCallback callback;
+        void* context;
+        uint32_t generation;    // Bumped on every reuse, part of TimerId
+        uint32_t heap_index;    // Position in heap, or NOT_QUEUED
+    };
+
+    static constexpr uint32_t NOT_QUEUED = 0xFFFFFFFF;
+
+    static Timer timers[MAX_TIMERS];
+    static uint8_t heap[MAX_TIMERS];    // Slot indices, min-heap by deadline
+    static uint32_t heap_size;
+    static uint64_t programmed;         // Current mtimecmp value
+    static TimerStats stats;
+
+    static void write_mtimecmp(uint64_t value);
+    static void program_next();
+    static bool earlier(uint32_t a, uint32_t b);
+    static void place(uint32_t index, uint8_t slot);
+    static void sift_up(uint32_t index);
+    static void sift_down(uint32_t index);
+    static void remove_at(uint32_t index);
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "cstdint"
+
+// External interrupt handler; runs in machine external interrupt context
+typedef void (*PlicHandler)(uint32_t source, void* context);
+
+// Driver for the QEMU virt PLIC, hart 0 machine-mode context
+//
+// Sources are routed through a registration table indexed by source ID.
+// dispatch() keeps claiming until the PLIC reports nothing pending, so a
+// burst on several sources is serviced in one trap entry; each claim is
+// completed after its handler returns. Sources without a handler are
+// posted to InterruptController's event queue for the main loop.
+//
+// Priorities are 1 (lowest) to 7; 0 masks a source. A source only
+// interrupts this hart while its priority is above the threshold.
+class Plic {
+public:
+    static constexpr uint32_t MAX_PRIORITY = 7;
+
+    // Disable every source, open the threshold and enable MEIE
+    static void init();
+
+    // Hook a source and enable it at the given priority.
+    // False for source 0, out-of-range sources or priorities.
+    static bool register_handler(uint32_t source, PlicHandler handler, void* context,
+                                 uint32_t priority = 1);
+    static void unregister_handler(uint32_t source);
+
+    static void set_priority(uint32_t source, uint32_t priority);
+    static uint32_t get_priority(uint32_t source);
+
+    // Mask every source whose priority is <= threshold
+    static void set_threshold(uint32_t threshold);
+    static uint32_t get_threshold();
+
+    static void enable_source(uint32_t source);
+    static void disable_source(uint32_t source);
+
+    // Claim/handle/complete until no source is pending.
+    // Called from machine_external_interrupt_handler.
+    static void dispatch();
+
+private:
+    struct Registration {
+        PlicHandler handler;
+        void* context;
+    };
+
+    static Registration handlers[];
+};
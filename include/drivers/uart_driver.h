@@ -0,0 +1,87 @@
+#pragma once
+
+#include "cstddef"
+#include "cstdint"
+#include "spsc_ring.h"
+
+// UART driver statistics
+struct UartStats {
+    uint32_t tx_bytes;          // Bytes moved from the TX ring to the UART
+    uint32_t rx_bytes;          // Bytes moved from the UART to the RX ring
+    uint32_t tx_interrupts;     // THR-empty interrupts serviced
+    uint32_t rx_interrupts;     // Receive-data interrupts serviced
+    uint32_t tx_stalls;         // write_all() waits for TX ring space
+    uint32_t rx_overruns;       // Bytes dropped because the RX ring was full
+};
+
+// Interrupt-driven, buffered driver for the 16550 UART on QEMU virt
+//
+// write() copies into a TX ring and returns at once; the THR-empty
+// interrupt (PLIC source 10, dispatched by Plic) drains the ring 16 bytes
+// (one FIFO) at a time, so the CPU only touches the UART once per FIFO
+// instead of spinning on LSR for every byte. Received bytes
+// are moved into an RX ring by the receive-data interrupt and taken with
+// read(). Both rings are SpscRings, so the main loop never masks
+// interrupts to use them. Once the Scheduler is running, writers waiting
+// for ring space and readers waiting for input block their task and are
+// woken from the interrupt handler.
+//
+// Until init() is called (and whenever global interrupts are disabled)
+// output falls back to polling, so early boot and fault paths still print.
+class UartDriver {
+public:
+    static constexpr uint32_t TX_BUFFER_SIZE = 512;
+    static constexpr uint32_t RX_BUFFER_SIZE = 128;
+    static constexpr uint32_t PLIC_SOURCE = 10;     // UART0 IRQ on QEMU virt
+
+    // Enable the FIFOs and the receive interrupt, and register with the
+    // PLIC (call Plic::init() first)
+    static void init();
+
+    static bool is_enabled() { return enabled; }
+
+    // Queue up to len bytes without blocking; returns how many were queued.
+    // A short count means the TX ring is full (backpressure).
+    static size_t write(const char* buf, size_t len);
+
+    // Queue all len bytes, blocking the calling task (or sleeping in wfi
+    // before the scheduler runs) while the TX ring is full. With global
+    // interrupts disabled it flushes the ring and polls the bytes out
+    // instead, so they are on the wire when it returns.
+    static void write_all(const char* buf, size_t len);
+
+    // Take up to max_len received bytes without blocking
+    static size_t read(char* buf, size_t max_len);
+
+    // Take at least one byte, blocking the calling task (or sleeping in
+    // wfi before the scheduler runs) until input arrives
+    static size_t read_blocking(char* buf, size_t max_len);
+
+    // Bytes queued but not yet handed to the UART
+    static size_t tx_pending() { return tx_ring.size(); }
+    // Bytes the TX ring can still take without blocking
+    static size_t tx_free() { return TX_BUFFER_SIZE - tx_ring.size(); }
+    static size_t rx_available() { return rx_ring.size(); }
+
+    // Wait until the TX ring and the UART transmitter are empty
+    static void flush();
+
+    // Write bytes straight to the THR, spinning on LSR (the pre-driver path)
+    static void write_polled(const char* buf, size_t len);
+
+    // PLIC handler for PLIC_SOURCE
+    static void handle_interrupt();
+
+    static const UartStats& get_stats() { return stats; }
+
+private:
+    static SpscRing<uint8_t, TX_BUFFER_SIZE> tx_ring;
+    static SpscRing<uint8_t, RX_BUFFER_SIZE> rx_ring;
+    static UartStats stats;
+    static bool enabled;
+
+    static void start_tx();
+    static void service_tx();
+    static void service_rx();
+    static void wait_for_tx();
+};
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// Sorted flat map for baremetal environment
+//
+// Entries are kept in one contiguous array ordered by key, so lookups are
+// a binary search, iteration is in ascending key order and walks memory
+// linearly. Inserting or erasing in the middle shifts the tail, which makes
+// FlatMap best for tables that are built once (see insert_sorted_range)
+// and then mostly read. Same API as SimpleMap; Key needs operator<.
+//
+// Any insert or erase invalidates pointers and iterators into the map.
+template<typename Key, typename Value>
+class FlatMap {
+public:
+    struct Entry {
+        Key key;
+        Value value;
+    };
+
+private:
+    Entry* data;
+    size_t size_;
+    size_t capacity_;
+
+    // First entry whose key is not less than key
+    size_t lower_bound(const Key& key) const {
+        size_t lo = 0;
+        size_t len = size_;
+        while (len > 0) {
+            size_t half = len / 2;
+            if (data[lo + half].key < key) {
+                lo += half + 1;
+                len -= half + 1;
+            } else {
+                len = half;
+            }
+        }
+        return lo;
+    }
+
+    bool matches(size_t pos, const Key& key) const {
+        return pos < size_ && !(key < data[pos].key);
+    }
+
+    void reallocate(size_t new_capacity) {
+        Entry* fresh = static_cast<Entry*>(::operator new(new_capacity * sizeof(Entry)));
+        for (size_t i = 0; i < size_; ++i) {
+            new (&fresh[i]) Entry(std::move(data[i]));
+            data[i].~Entry();
+        }
+        ::operator delete(static_cast<void*>(data));
+        data = fresh;
+        capacity_ = new_capacity;
+    }
+
+    // Open a gap at pos and construct the entry there
+    Entry& insert_at(size_t pos, Entry&& entry) {
+        if (size_ == capacity_) {
+            reallocate(capacity_ ? capacity_ * 2 : 8);
+        }
+        if (pos == size_) {
+            new (&data[size_]) Entry(std::move(entry));
+        } else {
+            new (&data[size_]) Entry(std::move(data[size_ - 1]));
+            for (size_t i = size_ - 1; i > pos; --i) {
+                data[i] = std::move(data[i - 1]);
+            }
+            data[pos] = std::move(entry);
+        }
+        size_++;
+        return data[pos];
+    }
+
+    void copy_from(const FlatMap& other) {
+        reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i) {
+            new (&data[i]) Entry(other.data[i]);
+        }
+        size_ = other.size_;
+    }
+
+public:
+    FlatMap() : data(nullptr), size_(0), capacity_(0) {}
+
+    ~FlatMap() {
+        clear();
+        ::operator delete(static_cast<void*>(data));
+    }
+
+    // Copy constructor
+    FlatMap(const FlatMap& other) : data(nullptr), size_(0), capacity_(0) {
+        copy_from(other);
+    }
+
+    // Move constructor: takes over the storage
+    FlatMap(FlatMap&& other) noexcept : data(other.data), size_(other.size_), capacity_(other.capacity_) {
+        other.data = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    // Assignment operator
+    FlatMap& operator=(const FlatMap& other) {
+        if (this != &other) {
+            clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    // Move assignment operator
+    FlatMap& operator=(FlatMap&& other) noexcept {
+        if (this != &other) {
+            clear();
+            ::operator delete(static_cast<void*>(data));
+            data = other.data;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    void reserve(size_t count) {
+        if (count > capacity_) {
+            reallocate(count);
+        }
+    }
+
+    void insert(const Key& key, const Value& value) {
+        size_t pos = lower_bound(key);
+        if (matches(pos, key)) {
+            data[pos].value = value;
+            return;
+        }
+        insert_at(pos, Entry{key, value});
+    }
+
+    void insert(const Key& key, Value&& value) {
+        size_t pos = lower_bound(key);
+        if (matches(pos, key)) {
+            data[pos].value = std::move(value);
+            return;
+        }
+        insert_at(pos, Entry{key, std::move(value)});
+    }
+
+    // Bulk load from a range sorted by key, each element exposing .key and
+    // .value (an Entry array, or a SimpleMap/HashMap iterator range). The
+    // existing table and the range are merged into new storage in a single
+    // pass; on equal keys the range wins, like insert(). An unsorted range
+    // falls back to element-wise insert.
+    template<typename It>
+    void insert_sorted_range(It first, It last) {
+        // Count the range and check its order without touching the table
+        size_t count = 0;
+        bool sorted = true;
+        const Key* prev = nullptr;
+        for (It it = first; it != last; ++it) {
+            if (prev && (*it).key < *prev) {
+                sorted = false;
+                break;
+            }
+            prev = &(*it).key;
+            count++;
+        }
+        if (!sorted) {
+            for (It it = first; it != last; ++it) {
+                insert((*it).key, (*it).value);
+            }
+            return;
+        }
+
+        size_t merged_capacity = size_ + count;
+        Entry* merged = static_cast<Entry*>(::operator new(merged_capacity * sizeof(Entry)));
+        size_t out = 0;
+        size_t i = 0;
+        It it = first;
+        while (i < size_ || it != last) {
+            if (it == last || (i < size_ && data[i].key < (*it).key)) {
+                new (&merged[out++]) Entry(std::move(data[i]));
+                data[i++].~Entry();
+                continue;
+            }
+            if (i < size_ && !((*it).key < data[i].key)) {
+                // Same key in both: drop the existing entry
+                data[i++].~Entry();
+            }
+            if (out > 0 && !(merged[out - 1].key < (*it).key)) {
+                // Duplicate within the range: last one wins
+                merged[out - 1].value = (*it).value;
+            } else {
+                new (&merged[out++]) Entry{(*it).key, (*it).value};
+            }
+            ++it;
+        }
+
+        ::operator delete(static_cast<void*>(data));
+        data = merged;
+        size_ = out;
+        capacity_ = merged_capacity;
+    }
+
+    Value* find(const Key& key) {
+        size_t pos = lower_bound(key);
+        return matches(pos, key) ? &data[pos].value : nullptr;
+    }
+
+    // Operator[] for map[key] = value syntax
+    Value& operator[](const Key& key) {
+        size_t pos = lower_bound(key);
+        if (matches(pos, key)) {
+            return data[pos].value;
+        }
+        return insert_at(pos, Entry{key, Value{}}).value;
+    }
+
+    // Emplace back functionality for map
+    template<typename... Args>
+    void emplace_back(const Key& key, Args&&... args) {
+        size_t pos = lower_bound(key);
+        if (matches(pos, key)) {
+            data[pos].value = Value(std::forward<Args>(args)...);
+            return;
+        }
+        insert_at(pos, Entry{key, Value(std::forward<Args>(args)...)});
+    }
+
+    bool erase(const Key& key) {
+        size_t pos = lower_bound(key);
+        if (!matches(pos, key)) return false;
+        for (size_t i = pos; i + 1 < size_; ++i) {
+            data[i] = std::move(data[i + 1]);
+        }
+        data[--size_].~Entry();
+        return true;
+    }
+
+    // Destroy all entries but keep the storage for reuse
+    void clear() {
+        for (size_t i = 0; i < size_; ++i) {
+            data[i].~Entry();
+        }
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t capacity() const { return capacity_; }
+
+    // Iterator-like access in ascending key order
+    class Iterator {
+    private:
+        Entry* current;
+        Entry* last;
+    public:
+        Iterator(Entry* entry, Entry* end) : current(entry), last(end) {}
+
+        bool operator!=(const Iterator& other) const {
+            return current != other.current;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return current == other.current;
+        }
+
+        Iterator& operator++() {
+            if (current != last) current++;
+            return *this;
+        }
+
+        Iterator& operator--() {
+            current--;
+            return *this;
+        }
+
+        Entry& operator*() { return *current; }
+        Entry* operator->() { return current; }
+
+        // Check if iterator is valid
+        bool is_valid() const { return current != last; }
+
+        // Get key and value directly
+        const Key& key() const { return current->key; }
+        Value& value() { return current->value; }
+        const Value& value() const { return current->value; }
+    };
+
+    Iterator begin() { return Iterator(data, data + size_); }
+    Iterator end() { return Iterator(data + size_, data + size_); }
+
+    // Find method that returns iterator
+    Iterator find_iter(const Key& key) {
+        size_t pos = lower_bound(key);
+        return matches(pos, key) ? Iterator(data + pos, data + size_) : end();
+    }
+};
@@ -0,0 +1,451 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// Default hash: murmur3 finalizer over the key bits
+template<typename Key>
+struct DefaultHash {
+    uint32_t operator()(const Key& key) const {
+        uint64_t bits = static_cast<uint64_t>(key);
+        uint32_t h = static_cast<uint32_t>(bits) ^ static_cast<uint32_t>(bits >> 32);
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+};
+
+template<typename T>
+struct DefaultHash<T*> {
+    uint32_t operator()(T* key) const {
+        return DefaultHash<uintptr_t>()(reinterpret_cast<uintptr_t>(key));
+    }
+};
+
+// Open-addressing hash map for baremetal environment
+//
+// Entries live in one flat array probed with robin-hood linear probing; a
+// parallel byte array holds each slot's probe distance so misses stop after
+// a few metadata bytes instead of chasing pointers. Same API as SimpleMap.
+//
+// Growth is incremental: when the load factor is exceeded a table twice the
+// size is allocated and every mutating call migrates at most MIGRATE_STEP
+// slots from the old table, so no single insert pays for a full rehash.
+// Lookups consult both tables while a migration is in flight.
+//
+// Any insert or erase invalidates pointers and iterators into the map.
+template<typename Key, typename Value, typename Hash = DefaultHash<Key>>
+class HashMap {
+public:
+    struct Entry {
+        Key key;
+        Value value;
+    };
+
+    static constexpr uint32_t INITIAL_CAPACITY = 8;
+    static constexpr uint32_t MIGRATE_STEP = 8;
+
+private:
+    // Slot metadata: 0 = empty, TOMBSTONE = erased from a draining table,
+    // otherwise probe distance + 1. Distances saturate at MAX_DISTANCE;
+    // the exact value of a saturated slot is recomputed from its key's hash.
+    static constexpr uint8_t EMPTY = 0;
+    static constexpr uint8_t TOMBSTONE = 0xFF;
+    static constexpr uint8_t MAX_DISTANCE = 0xFE;
+
+    struct Table {
+        Entry* entries;
+        uint8_t* meta;
+        uint32_t capacity;
+        uint32_t size;
+    };
+
+    Table table;        // Receives all inserts
+    Table old_table;    // Being drained into table, capacity 0 when idle
+    uint32_t migrate_pos;
+    Hash hasher;
+
+    static bool is_live(uint8_t meta) { return meta != EMPTY && meta != TOMBSTONE; }
+
+    static Table allocate_table(uint32_t capacity) {
+        Table t;
+        void* storage = ::operator new(capacity * sizeof(Entry) + capacity);
+        t.entries = static_cast<Entry*>(storage);
+        t.meta = reinterpret_cast<uint8_t*>(t.entries + capacity);
+        t.capacity = capacity;
+        t.size = 0;
+        for (uint32_t i = 0; i < capacity; ++i) {
+            t.meta[i] = EMPTY;
+        }
+        return t;
+    }
+
+    static void destroy_entries(Table& t) {
+        for (uint32_t i = 0; i < t.capacity; ++i) {
+            if (is_live(t.meta[i])) {
+                t.entries[i].~Entry();
+                t.meta[i] = EMPTY;
+            }
+        }
+        t.size = 0;
+    }
+
+    static void free_table(Table& t) {
+        if (t.capacity) {
+            destroy_entries(t);
+            ::operator delete(static_cast<void*>(t.entries));
+        }
+        t.entries = nullptr;
+        t.meta = nullptr;
+        t.capacity = 0;
+        t.size = 0;
+    }
+
+    uint32_t distance_at(const Table& t, uint32_t i) const {
+        uint8_t m = t.meta[i];
+        if (m != MAX_DISTANCE) return m;
+        return ((i - hasher(t.entries[i].key)) & (t.capacity - 1)) + 1;
+    }
+
+    int32_t find_slot(const Table& t, const Key& key, uint32_t h) const {
+        if (!t.capacity) return -1;
+        uint32_t mask = t.capacity - 1;
+        uint32_t i = h & mask;
+        for (uint32_t dist = 1; ; ++dist) {
+            uint8_t m = t.meta[i];
+            if (m == EMPTY) return -1;
+            if (m != TOMBSTONE) {
+                // Robin hood: a resident closer to home means the key is absent
+                if (distance_at(t, i) < dist) return -1;
+                if (t.entries[i].key == key) return static_cast<int32_t>(i);
+            }
+            i = (i + 1) & mask;
+        }
+    }
+
+    static uint8_t stored_distance(uint32_t dist) {
+        return dist < MAX_DISTANCE ? static_cast<uint8_t>(dist) : MAX_DISTANCE;
+    }
+
+    // Place an entry known to be absent and return its slot
+    uint32_t place(Table& t, Entry&& entry, uint32_t h) {
+        uint32_t mask = t.capacity - 1;
+        uint32_t i = h & mask;
+        uint32_t dist = 1;
+        int32_t placed = -1;
+        Entry carry(std::move(entry));
+        for (;;) {
+            uint8_t m = t.meta[i];
+            if (m == EMPTY) {
+                new (&t.entries[i]) Entry(std::move(carry));
+                t.meta[i] = stored_distance(dist);
+                t.size++;
+                return placed >= 0 ? static_cast<uint32_t>(placed) : i;
+            }
+            uint32_t resident = distance_at(t, i);
+            if (resident < dist) {
+                // Steal the slot from a richer resident and carry it onward
+                Entry displaced(std::move(t.entries[i]));
+                t.entries[i] = std::move(carry);
+                carry = std::move(displaced);
+                t.meta[i] = stored_distance(dist);
+                dist = resident;
+                if (placed < 0) placed = static_cast<int32_t>(i);
+            }
+            i = (i + 1) & mask;
+            dist++;
+        }
+    }
+
+    // Backward-shift deletion keeps probe sequences tombstone free
+    void remove_slot(Table& t, uint32_t i) {
+        uint32_t mask = t.capacity - 1;
+        t.entries[i].~Entry();
+        for (;;) {
+            uint32_t next = (i + 1) & mask;
+            uint32_t dist = distance_at(t, next);
+            if (dist <= 1) {
+                t.meta[i] = EMPTY;
+                break;
+            }
+            new (&t.entries[i]) Entry(std::move(t.entries[next]));
+            t.entries[next].~Entry();
+            t.meta[i] = stored_distance(dist - 1);
+            i = next;
+        }
+        t.size--;
+    }
+
+    void migrate(uint32_t budget) {
+        while (old_table.capacity && budget--) {
+            uint32_t i = migrate_pos++;
+            if (is_live(old_table.meta[i])) {
+                Entry& entry = old_table.entries[i];
+                place(table, std::move(entry), hasher(entry.key));
+                entry.~Entry();
+                old_table.meta[i] = TOMBSTONE;
+                old_table.size--;
+            }
+            if (migrate_pos == old_table.capacity) {
+                free_table(old_table);
+            }
+        }
+    }
+
+    void grow() {
+        // Finish any previous migration before starting another
+        migrate(old_table.capacity);
+        if (!table.capacity) {
+            table = allocate_table(INITIAL_CAPACITY);
+            return;
+        }
+        old_table = table;
+        table = allocate_table(old_table.capacity * 2);
+        migrate_pos = 0;
+    }
+
+    // Insert an entry known to be absent, growing as needed
+    Entry& insert_new(Entry&& entry, uint32_t h) {
+        migrate(MIGRATE_STEP);
+        // Keep the load factor at or below 80%
+        if ((size() + 1) * 5 > table.capacity * 4) {
+            grow();
+        }
+        return table.entries[place(table, std::move(entry), h)];
+    }
+
+    Entry* find_entry(const Key& key) {
+        uint32_t h = hasher(key);
+        int32_t slot = find_slot(old_table, key, h);
+        if (slot >= 0) return &old_table.entries[slot];
+        slot = find_slot(table, key, h);
+        if (slot >= 0) return &table.entries[slot];
+        return nullptr;
+    }
+
+    void copy_from(const HashMap& other) {
+        for (uint32_t i = 0; i < other.old_table.capacity; ++i) {
+            if (is_live(other.old_table.meta[i])) {
+                insert(other.old_table.entries[i].key, other.old_table.entries[i].value);
+            }
+        }
+        for (uint32_t i = 0; i < other.table.capacity; ++i) {
+            if (is_live(other.table.meta[i])) {
+                insert(other.table.entries[i].key, other.table.entries[i].value);
+            }
+        }
+    }
+
+public:
+    HashMap() : table{nullptr, nullptr, 0, 0}, old_table{nullptr, nullptr, 0, 0}, migrate_pos(0) {}
+
+    explicit HashMap(const Hash& hash) : HashMap() {
+        hasher = hash;
+    }
+
+    ~HashMap() {
+        free_table(old_table);
+        free_table(table);
+    }
+
+    // Copy constructor
+    HashMap(const HashMap& other) : HashMap() {
+        hasher = other.hasher;
+        copy_from(other);
+    }
+
+    // Move constructor: takes over both tables
+    HashMap(HashMap&& other) noexcept
+        : table(other.table), old_table(other.old_table), migrate_pos(other.migrate_pos), hasher(other.hasher) {
+        other.table = Table{nullptr, nullptr, 0, 0};
+        other.old_table = Table{nullptr, nullptr, 0, 0};
+    }
+    
+    // Assignment operator
+    HashMap& operator=(const HashMap& other) {
+        if (this != &other) {
+            clear();
+            hasher = other.hasher;
+            copy_from(other);
+        }
+        return *this;
+    }
+    
+    // Move assignment operator
+    HashMap& operator=(HashMap&& other) noexcept {
+        if (this != &other) {
+            free_table(old_table);
+            free_table(table);
+            table = other.table;
+            old_table = other.old_table;
+            migrate_pos = other.migrate_pos;
+            hasher = other.hasher;
+            other.table = Table{nullptr, nullptr, 0, 0};
+            other.old_table = Table{nullptr, nullptr, 0, 0};
+        }
+        return *this;
+    }
+
+    void insert(const Key& key, const Value& value) {
+        Entry* entry = find_entry(key);
+        if (entry) {
+            entry->value = value;
+            return;
+        }
+        insert_new(Entry{key, value}, hasher(key));
+    }
+
+    void insert(const Key& key, Value&& value) {
+        Entry* entry = find_entry(key);
+        if (entry) {
+            entry->value = std::move(value);
+            return;
+        }
+        insert_new(Entry{key, std::move(value)}, hasher(key));
+    }
+
+    Value* find(const Key& key) {
+        Entry* entry = find_entry(key);
+        return entry ? &entry->value : nullptr;
+    }
+
+    // Operator[] for map[key] = value syntax
+    Value& operator[](const Key& key) {
+        Entry* entry = find_entry(key);
+        if (entry) {
+            return entry->value;
+        }
+        return insert_new(Entry{key, Value{}}, hasher(key)).value;
+    }
+
+    // Emplace back functionality for map
+    template<typename... Args>
+    void emplace_back(const Key& key, Args&&... args) {
+        Entry* entry = find_entry(key);
+        if (entry) {
+            entry->value = Value(std::forward<Args>(args)...);
+            return;
+        }
+        insert_new(Entry{key, Value(std::forward<Args>(args)...)}, hasher(key));
+    }
+
+    bool erase(const Key& key) {
+        migrate(MIGRATE_STEP);
+        uint32_t h = hasher(key);
+        int32_t slot = find_slot(old_table, key, h);
+        if (slot >= 0) {
+            // The draining table is scanned by index, so leave a tombstone
+            old_table.entries[slot].~Entry();
+            old_table.meta[slot] = TOMBSTONE;
+            old_table.size--;
+            return true;
+        }
+        slot = find_slot(table, key, h);
+        if (slot >= 0) {
+            remove_slot(table, static_cast<uint32_t>(slot));
+            return true;
+        }
+        return false;
+    }
+
+    // Destroy all entries but keep the table storage for reuse
+    void clear() {
+        free_table(old_table);
+        destroy_entries(table);
+    }
+
+    // Preallocate for count entries so later inserts never grow
+    void reserve(size_t count) {
+        uint32_t capacity = table.capacity ? table.capacity : INITIAL_CAPACITY;
+        while (count * 5 > capacity * 4) {
+            capacity *= 2;
+        }
+        if (capacity <= table.capacity) return;
+        migrate(old_table.capacity);
+        Table previous = table;
+        table = allocate_table(capacity);
+        for (uint32_t i = 0; i < previous.capacity; ++i) {
+            if (is_live(previous.meta[i])) {
+                Entry& entry = previous.entries[i];
+                place(table, std::move(entry), hasher(entry.key));
+            }
+        }
+        free_table(previous);
+    }
+
+    size_t size() const { return table.size + old_table.size; }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return table.capacity; }
+    bool rehashing() const { return old_table.capacity != 0; }
+
+    // Iterator-like access, visits the draining table first
+    class Iterator {
+    private:
+        HashMap* map;
+        uint32_t index;
+
+        uint32_t limit() const { return map->old_table.capacity + map->table.capacity; }
+
+        Entry* entry_at(uint32_t i) const {
+            if (i < map->old_table.capacity) return &map->old_table.entries[i];
+            return &map->table.entries[i - map->old_table.capacity];
+        }
+
+        bool live_at(uint32_t i) const {
+            if (i < map->old_table.capacity) return is_live(map->old_table.meta[i]);
+            return is_live(map->table.meta[i - map->old_table.capacity]);
+        }
+
+        void skip_free() {
+            while (index < limit() && !live_at(index)) index++;
+        }
+
+    public:
+        Iterator(HashMap* m, uint32_t i) : map(m), index(i) { skip_free(); }
+
+        bool operator!=(const Iterator& other) const {
+            return index != other.index;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index == other.index;
+        }
+
+        Iterator& operator++() {
+            if (index < limit()) {
+                index++;
+                skip_free();
+            }
+            return *this;
+        }
+
+        Entry& operator*() { return *entry_at(index); }
+        Entry* operator->() { return entry_at(index); }
+
+        // Check if iterator is valid
+        bool is_valid() const { return index < limit(); }
+
+        // Get key and value directly
+        const Key& key() const { return entry_at(index)->key; }
+        Value& value() { return entry_at(index)->value; }
+        const Value& value() const { return entry_at(index)->value; }
+    };
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, old_table.capacity + table.capacity); }
+
+    // Find method that returns iterator
+    Iterator find_iter(const Key& key) {
+        uint32_t h = hasher(key);
+        int32_t slot = find_slot(old_table, key, h);
+        if (slot >= 0) return Iterator(this, static_cast<uint32_t>(slot));
+        slot = find_slot(table, key, h);
+        if (slot >= 0) return Iterator(this, old_table.capacity + static_cast<uint32_t>(slot));
+        return end();
+    }
+};
@@ -1,16 +1,8 @@
 #pragma once
 
 #include "cstdint"
-
-// RISC-V CSR definitions
-#define CSR_MSTATUS     0x300
-#define CSR_MIE         0x304
-#define CSR_MTVEC       0x305
-#define CSR_MSCRATCH    0x340
-#define CSR_MEPC        0x341
-#define CSR_MCAUSE      0x342
-#define CSR_MTVAL       0x343
-#define CSR_MIP         0x344
+#include "csr.h"
+#include "spsc_ring.h"
 
 // Machine interrupt enable bits
 #define MIE_MSIE        (1 << 3)   // Machine software interrupt enable
@@ -33,6 +25,60 @@
 #define CAUSE_SUPERVISOR_TIMER_INT      5
 #define CAUSE_SUPERVISOR_EXTERNAL_INT   9
 
+// CLINT software interrupt registers, one word per hart (QEMU virt).
+// MIP.MSIP is read-only in machine mode; it mirrors this register.
+#define CLINT_BASE              0x02000000
+#define CLINT_MSIP(hart)        (CLINT_BASE + 4 * (hart))
+#define CLINT_MSIP_HART0        CLINT_MSIP(0)
+#define CLINT_MTIMECMP_HART0    (CLINT_BASE + 0x4000)
+#define CLINT_MTIME             (CLINT_BASE + 0xBFF8)
+
+// PLIC registers for hart 0 machine mode (QEMU virt, context 0)
+#define PLIC_BASE               0x0C000000
+#define PLIC_PRIORITY(source)   (PLIC_BASE + 4 * (source))
+#define PLIC_ENABLE_M_HART0     (PLIC_BASE + 0x2000)
+#define PLIC_THRESHOLD_M_HART0  (PLIC_BASE + 0x200000)
+#define PLIC_CLAIM_M_HART0      (PLIC_BASE + 0x200004)
+#define PLIC_MAX_SOURCES        64      // Sources 1-63 (UART0 is 10)
+
+// Event handed from an interrupt handler to the main loop
+struct InterruptEvent {
+    uint32_t cause;         // mcause of the interrupt
+    uint32_t source;        // PLIC source ID for external interrupts
+    uint32_t timestamp;     // Low word of mcycle when the handler ran
+};
+
+// mcycle stamps written by the trap entry stubs in start.S (TRAP_TIMING)
+struct TrapTiming {
+    uint32_t handler_enter;     // Context saved, about to call the C handler
+    uint32_t handler_exit;      // C handler returned, about to restore
+};
+
+// Trap entry/exit latency in cycles, from measure_trap_latency()
+struct TrapLatency {
+    uint32_t frame_bytes;       // Trap frame size chosen at build time
+    uint32_t entry_min;         // Software interrupt raised -> C handler
+    uint32_t entry_avg;
+    uint32_t exit_min;          // C handler returned -> interrupted code
+    uint32_t exit_avg;
+};
+
+extern "C" {
+    extern volatile TrapTiming trap_timing;
+    extern const uint32_t trap_frame_size;
+}
+
+// ISR (producer) to main loop (consumer) queue
+typedef SpscRing<InterruptEvent, 64> InterruptEventQueue;
+
+// Per-source external interrupt statistics (cycles from mcycle)
+struct ExternalSourceStats {
+    uint32_t count;             // Claims serviced
+    uint32_t latency_total;     // Dispatch entry -> handler start, summed
+    uint32_t latency_max;
+    uint32_t service_max;       // Handler run time
+};
+
 // Interrupt statistics
 struct InterruptStats {
     uint32_t machine_software_count;
@@ -42,6 +88,10 @@ struct InterruptStats {
     uint32_t supervisor_timer_count;
     uint32_t supervisor_external_count;
     uint32_t unhandled_exception_count;
+    uint32_t dropped_event_count;       // Events lost to a full event queue
+    uint32_t unclaimed_external_count;  // External traps with nothing to claim
+    uint32_t max_claims_per_trap;       // Most sources drained in one trap
+    ExternalSourceStats external_sources[PLIC_MAX_SOURCES];
 };
 
 // Forward declarations for friend functions
@@ -55,11 +105,17 @@ extern "C" {
     void supervisor_external_interrupt_handler();
 }
 
+class Plic;
+
 // Interrupt controller class
 class InterruptController {
 private:
     static InterruptStats stats;
     static bool initialized;
+    static InterruptEventQueue event_queue;
+    
+    // Queue an event from handler context; counts it as dropped when full
+    static void post_event(uint32_t cause, uint32_t source);
     
     // Friend functions for interrupt handlers
     friend void ::unhandled_exception_handler();
@@ -69,37 +125,72 @@ private:
     friend void ::supervisor_software_interrupt_handler();
     friend void ::supervisor_timer_interrupt_handler();
     friend void ::supervisor_external_interrupt_handler();
+    friend class Plic;
     
 public:
     // Initialize interrupt system
     static void init();
     
     // Enable/disable global interrupts
-    static void enable_global_interrupts();
-    static void disable_global_interrupts();
+    static void enable_global_interrupts() { csr<CSR_MSTATUS>::set(MSTATUS_MIE); }
+    static void disable_global_interrupts() { csr<CSR_MSTATUS>::clear(MSTATUS_MIE); }
     
     // Enable/disable specific interrupts
-    static void enable_machine_timer_interrupt();
-    static void disable_machine_timer_interrupt();
-    static void enable_machine_software_interrupt();
-    static void disable_machine_software_interrupt();
-    static void enable_machine_external_interrupt();
-    static void disable_machine_external_interrupt();
+    static void enable_machine_timer_interrupt() { csr<CSR_MIE>::set(MIE_MTIE); }
+    static void disable_machine_timer_interrupt() { csr<CSR_MIE>::clear(MIE_MTIE); }
+    static void enable_machine_software_interrupt() { csr<CSR_MIE>::set(MIE_MSIE); }
+    static void disable_machine_software_interrupt() { csr<CSR_MIE>::clear(MIE_MSIE); }
+    static void enable_machine_external_interrupt() { csr<CSR_MIE>::set(MIE_MEIE); }
+    static void disable_machine_external_interrupt() { csr<CSR_MIE>::clear(MIE_MEIE); }
     
     // Trigger software interrupt
     static void trigger_software_interrupt();
     static void clear_software_interrupt();
     
+    // Time rounds of software interrupts through the trap entry stubs.
+    // Needs global interrupts enabled and a TRAP_TIMING=1 build.
+    static void measure_trap_latency(uint32_t rounds, TrapLatency& result);
+    
     // Get interrupt statistics
     static const InterruptStats& get_stats() { return stats; }
     
     // Reset statistics
     static void reset_stats();
     
-    // CSR access functions
-    static uint32_t read_csr(uint32_t csr);
-    static void write_csr(uint32_t csr, uint32_t value);
-    static void set_csr_bits(uint32_t csr, uint32_t bits);
-    static void clear_csr_bits(uint32_t csr, uint32_t bits);
+    // Take events posted by the handlers, without masking interrupts.
+    // Main-loop only: the queue has a single consumer.
+    static bool poll_event(InterruptEvent& event) { return event_queue.try_pop(event); }
+    static uint32_t drain_events(InterruptEvent* events, uint32_t max_count) {
+        return event_queue.pop_batch(events, max_count);
+    }
+    
+    // CSR access functions (thin wrappers over csr<>; the CSR number is a
+    // template argument, e.g. read_csr<CSR_MCAUSE>())
+    template<uint32_t Csr>
+    static uint32_t read_csr() { return csr<Csr>::read(); }
+    template<uint32_t Csr>
+    static void write_csr(uint32_t value) { csr<Csr>::write(value); }
+    template<uint32_t Csr>
+    static void set_csr_bits(uint32_t bits) { csr<Csr>::set(bits); }
+    template<uint32_t Csr>
+    static void clear_csr_bits(uint32_t bits) { csr<Csr>::clear(bits); }
 };
 
+// Masks machine interrupts for its lifetime and restores the previous
+// mstatus.MIE on destruction, so guards nest and are safe in handlers
+class InterruptGuard {
+private:
+    uint32_t saved_mstatus;
+    
+public:
+    InterruptGuard() : saved_mstatus(csr<CSR_MSTATUS>::read_clear(MSTATUS_MIE)) {}
+    
+    ~InterruptGuard() {
+        if (saved_mstatus & MSTATUS_MIE) {
+            csr<CSR_MSTATUS>::set(MSTATUS_MIE);
+        }
+    }
+    
+    InterruptGuard(const InterruptGuard&) = delete;
+    InterruptGuard& operator=(const InterruptGuard&) = delete;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "cstddef"
+#include "cstdint"
+
+// Set of jobs spread over the harts, waited for together
+//
+// run() queues a job on the calling hart's deque (Smp::submit), where idle
+// harts steal it; wait() returns once every job has finished and lets the
+// waiting hart run queued or stolen jobs meanwhile instead of spinning.
+// Job records live in the group, so a group holds at most MAX_JOBS
+// outstanding jobs; beyond that (or with a full deque) run() executes the
+// job inline. Jobs follow the Smp rules: no heap, UART or scheduler calls.
+class TaskGroup {
+public:
+    static constexpr uint32_t MAX_JOBS = 16;
+
+    TaskGroup() : pending(0), used(0) {}
+    ~TaskGroup() { wait(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(void (*function)(void* arg), void* arg);
+    void wait();
+
+private:
+    struct Job {
+        TaskGroup* group;
+        void (*function)(void* arg);
+        void* arg;
+    };
+
+    Job jobs[MAX_JOBS];
+    uint32_t pending;       // Jobs queued or running
+    uint32_t used;          // Records handed out since the last wait()
+
+    static void execute(void* record);
+};
+
+// Body of a parallel loop: process indices [begin, end)
+typedef void (*RangeFunction)(size_t begin, size_t end, void* context);
+
+// Run function over [begin, end) in chunks of grain indices
+//
+// The range is not pre-split: each participating hart claims the next
+// chunk with one atomic add until the range is used up, so harts that
+// start late or run slower simply take fewer chunks. grain trades the
+// per-chunk claim (a few dozen cycles) against balance at the end of the
+// loop; ranges no larger than one chunk run inline on the caller.
+//
+// With a single hart the chunks run inline on the caller, which yields to
+// other ready scheduler tasks between chunks so a long loop does not
+// starve them.
+void parallel_for(size_t begin, size_t end, size_t grain, RangeFunction function, void* context);
+
+// Same for any callable taking (size_t begin, size_t end), e.g. a lambda
+template<typename Function>
+void parallel_for(size_t begin, size_t end, size_t grain, const Function& function) {
+    parallel_for(begin, end, grain, [](size_t first, size_t last, void* context) {
+        (*static_cast<const Function*>(context))(first, last);
+    }, const_cast<Function*>(&function));
+}
+
+// Harts parallel_for uses: Smp::hart_count(), capped by the limit (0 = no
+// limit); lets benchmarks measure scaling from 1 to N harts in one run
+uint32_t parallel_concurrency();
+void set_parallel_concurrency(uint32_t harts);
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "cstddef"
+#include "cstdint"
+#include "clint_timer.h"
+
+struct Task;
+
+// Task entry point; returning from it ends the task
+typedef void (*TaskEntry)(void* arg);
+
+enum class TaskState : uint8_t {
+    Ready,
+    Running,
+    Sleeping,       // Waiting for a ClintTimer deadline
+    Waiting,        // Waiting on a TaskEvent
+    Finished
+};
+
+// Wake-up object for blocking tasks
+//
+// signal() wakes every waiting task, or latches if nobody is waiting so
+// the next wait() returns at once (the latch is consumed). Waiters should
+// re-check their condition after waking: a latched signal may be stale.
+// signal() is safe from interrupt handlers; wait() only from a task.
+class TaskEvent {
+public:
+    constexpr TaskEvent() : head(nullptr), tail(nullptr), pending(false) {}
+
+    void wait();
+    void signal();
+
+private:
+    Task* head;
+    Task* tail;
+    bool pending;
+};
+
+// Task control block
+struct Task {
+    uint32_t* sp;           // Saved stack pointer while switched out (start.S)
+    const char* name;
+    TaskEntry entry;
+    void* arg;
+    TaskState state;
+    uint8_t priority;       // 0 (lowest) to Scheduler::MAX_PRIORITIES - 1
+    bool woken;             // Made ready by a wakeup, latency pending
+    Task* next;             // Ready queue or TaskEvent wait list link
+    uint32_t* stack_base;   // Lowest address of the stack
+    uint32_t stack_size;
+    uint32_t switches;      // Times this task was switched in
+    uint32_t preemptions;   // Times it was switched out involuntarily
+    uint32_t wakeups;       // Wakeups from sleep or a TaskEvent
+    uint32_t ready_stamp;   // mcycle when last woken
+    uint32_t latency_max;   // Worst wakeup-to-running latency (cycles)
+    uint64_t latency_total;
+    uint64_t run_started;   // mcycle when last switched in
+    uint64_t run_cycles;    // Cycles spent running (CPU usage)
+    TaskEvent exited;       // Signalled when the task finishes (join)
+};
+
+struct SchedulerStats {
+    uint32_t context_switches;
+    uint32_t preemptions;       // Switches made from the MSIP handler
+    uint32_t switch_requests;   // Deferred switches requested via MSIP
+    uint32_t slice_expiries;    // Time slices that forced a rotation
+    uint32_t latency_max;       // Worst wakeup-to-running latency (cycles)
+    uint64_t idle_cycles;       // Cycles spent in wfi with nothing ready
+    uint64_t start_cycles;      // mcycle at init(), base for CPU shares
+};
+
+// Fixed-priority scheduler, cooperative by default, optionally preemptive
+//
+// init() adopts the caller (normally main, on the boot stack) as the first
+// task. Further tasks get stacks carved from the DTCM task stack pool in
+// linker.ld. The highest-priority ready task always runs next; equal
+// priorities round-robin. Ready tasks sit in one FIFO per priority with a
+// bitmap of non-empty levels, so picking the next task is a
+// count-leading-zeros, independent of the number of tasks.
+//
+// Cooperative mode: tasks run until they yield(), sleep() or wait on a
+// TaskEvent; interrupt handlers only make tasks ready.
+//
+// Preemptive mode (enable_preemption): making a task ready that outranks
+// the running one raises the machine software interrupt, and a periodic
+// ClintTimer slice does the same when other tasks of the running
+// priority are waiting. The switch itself happens in the MSIP handler
+// (deferred until every other handler has returned); its trap entry in
+// start.S also saves mepc/mstatus and the caller-saved FP registers so
+// the interrupted task can be suspended at any instruction. Both kinds of
+// switch go through context_switch, which saves the callee-saved state.
+//
+// Tasks are meant to be created at startup: stacks and TCBs of finished
+// tasks are not reclaimed.
+class Scheduler {
+public:
+    static constexpr uint32_t MAX_TASKS = 12;
+    static constexpr uint32_t MAX_PRIORITIES = 32;
+    static constexpr uint8_t DEFAULT_PRIORITY = 8;
+    static constexpr uint32_t DEFAULT_STACK_SIZE = 4096;
+    static constexpr uint32_t STACK_PAINT = 0x5A5A5A5A;
+
+    // Words in a switched-out context frame (start.S: ra, s0-s11, fs0-fs11)
+    static constexpr uint32_t CONTEXT_FRAME_WORDS = 40;
+
+    // Turn the calling thread of execution into the task "main"
+    static void init();
+    static bool is_running() { return current != nullptr; }
+
+    // nullptr when the TCB table or the stack pool is exhausted, or the
+    // priority is out of range
+    static Task* create(const char* name, TaskEntry entry, void* arg,
+                        uint32_t stack_size = DEFAULT_STACK_SIZE,
+                        uint8_t priority = DEFAULT_PRIORITY);
+
+    static void set_priority(Task* task, uint8_t priority);
+
+    // Preempt on wakeups of higher-priority tasks, and rotate equal
+    // priorities every slice_ticks of mtime
+    static void enable_preemption(uint64_t slice_ticks);
+    static void disable_preemption();
+    static bool is_preemptive() { return preemptive; }
+
+    // Let other ready tasks of the same or higher priority run
+    static void yield();
+
+    // Block the calling task for at least the given number of mtime ticks
+    static void sleep(uint64_t ticks);
+    static void sleep_ms(uint32_t ms);
+
+    // Block until the task has finished
+    static void join(Task* task);
+
+    // End the calling task (also done by returning from the entry point)
+    [[noreturn]] static void exit();
+
+    // Make a sleeping or waiting task ready; interrupt safe
+    static void wake(Task* task);
+
+    // Machine software interrupt: perform a requested deferred switch
+    static void handle_switch_request();
+
+    static Task* current_task() { return current; }
+    static uint32_t task_count() { return task_total; }
+    static Task* get_task(uint32_t index) { return index < task_total ? &tasks[index] : nullptr; }
+    static const SchedulerStats& get_stats() { return stats; }
+
+    // Running task's CPU cycles brought up to date (for reporting)
+    static void update_cpu_usage();
+
+    // Deepest stack use seen so far, from the untouched paint
+    static uint32_t stack_usage(const Task* task);
+
+    // Called from start.S when a new task first runs
+    static void task_main(Task* task);
+
+private:
+    static Task tasks[MAX_TASKS];
+    static uint32_t task_total;
+    static Task* current;
+    static Task* ready_heads[MAX_PRIORITIES];
+    static Task* ready_tails[MAX_PRIORITIES];
+    static uint32_t ready_bitmap;
+    static uint8_t* stack_pool_next;
+    static SchedulerStats stats;
+    static bool preemptive;
+    static bool switch_requested;
+    static bool slice_expired;
+    static uint64_t slice_ticks;
+    static TimerId slice_timer;
+
+    static void make_ready(Task* task, bool woken);
+    static Task* take_ready();
+    static int32_t highest_ready();
+    static void request_switch();
+    static void on_slice(void* context);
+    static void block();
+    static void switch_to(Task* next);
+
+    friend class TaskEvent;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "cstdint"
+#include "csr.h"
+#include "work_deque.h"
+
+// Unit of work handed between harts
+struct SmpJob {
+    void (*function)(void* arg);
+    void* arg;
+};
+
+// Per-hart counters; each is written only by its own hart
+struct HartStats {
+    uint32_t jobs_run;          // Jobs executed on this hart
+    uint32_t jobs_stolen;       // ...of which taken from another hart's deque
+    uint32_t steal_attempts;    // Steals tried, including lost races
+    uint32_t ipis_sent;
+    uint32_t wakeups;           // Times this hart left wfi
+};
+
+// Symmetric multiprocessing on the QEMU virt harts (-smp N)
+//
+// Every hart enters _start. Hart 0 clears BSS, runs the constructors and
+// main; the others take a per-hart stack from the .hart_stacks pool in
+// linker.ld, check in and wait in wfi until init() releases them. Harts
+// beyond MAX_HARTS are parked for good.
+//
+// Released harts run worker loops: pop a job from their own deque or
+// steal one from another hart's, and sleep in wfi when there is none.
+// submit() pushes onto the calling hart's deque and sends an IPI (CLINT
+// msip) to sleeping harts. Workers keep mstatus.MIE clear and only enable
+// MSIE in mie, so an IPI ends their wfi without taking a trap; interrupt
+// handling, the UART, the heap, the scheduler and the profiler all stay
+// on hart 0. Jobs must not use them; share data through atomics or the
+// locks in spinlock.h.
+class Smp {
+public:
+    // Keep in sync with SMP_MAX_HARTS in start.S and MAX_HARTS in linker.ld
+    static constexpr uint32_t MAX_HARTS = 4;
+    static constexpr uint32_t DEQUE_CAPACITY = 256;
+
+    static uint32_t hart_id() { return csr<CSR_MHARTID>::read(); }
+
+    // Hart 0: release the secondary harts that checked in and wait until
+    // they are running their worker loops
+    static void init();
+
+    // Harts running jobs (1 before init() or on a single-hart machine)
+    static uint32_t hart_count() { return harts_online; }
+
+    // Queue a job on the calling hart and wake idle harts; false when the
+    // deque is full (run the job inline instead)
+    static bool submit(const SmpJob& job);
+
+    // Run one job from the calling hart's deque, or steal one; false if
+    // none was found. Lets a waiting hart help instead of spinning.
+    static bool run_one();
+
+    // Raise the machine software interrupt on another hart
+    static void send_ipi(uint32_t hart);
+
+    static const HartStats& get_stats(uint32_t hart) { return harts[hart].stats; }
+    static void reset_stats();
+
+    // Entered from start.S by each released secondary hart
+    [[noreturn]] static void secondary_main(uint32_t hart);
+
+private:
+    struct alignas(64) Hart {
+        WorkStealingDeque<SmpJob, DEQUE_CAPACITY> deque;
+        HartStats stats;
+        uint32_t sleeping;      // In (or about to enter) wfi; wake with an IPI
+        uint32_t online;
+    };
+
+    static Hart harts[MAX_HARTS];
+    static uint32_t harts_online;
+
+    static bool find_job(uint32_t self, SmpJob& job);
+    static void wake_sleepers(uint32_t self);
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "cstdint"
+
+// Busy-wait locks for sharing data between harts (RV32A)
+//
+// Both locks only order memory between harts; they do not mask
+// interrupts. Code that can also race with a handler on its own hart has
+// to take an InterruptGuard first, and nothing may block or yield while
+// holding one. Hold times should be a few dozen instructions at most.
+
+static inline void cpu_relax() {
+    // Zihintpause pause; executes as a fence hint (a nop) where unsupported
+    asm volatile (".insn i 0x0F, 0, x0, x0, 0x010");
+}
+
+// Test-and-test-and-set lock: amoswap.w.aq to take it, a release store to
+// drop it. Waiters spin on a plain load so they do not hammer the line with
+// AMOs. Cheapest uncontended path, but not fair under contention.
+class SpinLock {
+public:
+    constexpr SpinLock() : locked(0) {}
+
+    SpinLock(const SpinLock&) = delete;
+    SpinLock& operator=(const SpinLock&) = delete;
+
+    void lock() {
+        while (__atomic_exchange_n(&locked, 1u, __ATOMIC_ACQUIRE)) {
+            while (__atomic_load_n(&locked, __ATOMIC_RELAXED)) {
+                cpu_relax();
+            }
+        }
+    }
+
+    bool try_lock() {
+        return !__atomic_exchange_n(&locked, 1u, __ATOMIC_ACQUIRE);
+    }
+
+    void unlock() {
+        __atomic_store_n(&locked, 0u, __ATOMIC_RELEASE);
+    }
+
+private:
+    uint32_t locked;
+};
+
+// Ticket lock: amoadd.w hands out tickets, harts are served in arrival
+// order. FIFO fairness costs one more counter and an AMO per acquisition.
+class TicketLock {
+public:
+    constexpr TicketLock() : next(0), serving(0) {}
+
+    TicketLock(const TicketLock&) = delete;
+    TicketLock& operator=(const TicketLock&) = delete;
+
+    void lock() {
+        uint32_t ticket = __atomic_fetch_add(&next, 1u, __ATOMIC_RELAXED);
+        while (__atomic_load_n(&serving, __ATOMIC_ACQUIRE) != ticket) {
+            cpu_relax();
+        }
+    }
+
+    void unlock() {
+        // Only the holder writes serving, so no AMO is needed
+        __atomic_store_n(&serving, serving + 1, __ATOMIC_RELEASE);
+    }
+
+private:
+    uint32_t next;
+    uint32_t serving;
+};
+
+// RAII holder for either lock
+template<typename Lock>
+class LockGuard {
+public:
+    explicit LockGuard(Lock& lock) : held(lock) { held.lock(); }
+    ~LockGuard() { held.unlock(); }
+
+    LockGuard(const LockGuard&) = delete;
+    LockGuard& operator=(const LockGuard&) = delete;
+
+private:
+    Lock& held;
+};
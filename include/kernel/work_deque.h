@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+
+// Bounded work-stealing deque (Chase-Lev) for one owner and many thieves
+//
+// The owning hart pushes and pops at the bottom (LIFO, so it keeps working
+// on what it just split off while the data is still warm); other harts
+// steal from the top (FIFO, taking the oldest and usually largest pieces).
+// Owner push/pop are plain loads and stores except when the deque is down
+// to its last item; steal is one compare-and-swap on top. top and bottom
+// are free-running counters compared through signed differences, so they
+// may wrap.
+//
+// Capacity is fixed (a power of two) instead of growing the array: push
+// returns false when full and the caller runs the item itself. T is copied
+// by assignment, so keep it small and trivially copyable.
+template<typename T, uint32_t Capacity>
+class WorkStealingDeque {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "WorkStealingDeque capacity must be a power of two");
+
+private:
+    static constexpr uint32_t MASK = Capacity - 1;
+    static constexpr uint32_t CACHE_LINE = 64;
+
+    // Thieves contend on top, the owner on bottom; keep them apart
+    alignas(CACHE_LINE) uint32_t top;       // Next slot to steal
+    alignas(CACHE_LINE) uint32_t bottom;    // Next slot to push, owner owned
+    alignas(CACHE_LINE) T slots[Capacity];
+
+    static int32_t distance(uint32_t from, uint32_t to) {
+        return (int32_t)(to - from);
+    }
+
+public:
+    constexpr WorkStealingDeque() : top(0), bottom(0), slots{} {}
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only: false if the deque is full
+    bool push(const T& item) {
+        uint32_t b = __atomic_load_n(&bottom, __ATOMIC_RELAXED);
+        uint32_t t = __atomic_load_n(&top, __ATOMIC_ACQUIRE);
+        if (distance(t, b) >= (int32_t)Capacity) {
+            return false;
+        }
+        slots[b & MASK] = item;
+        __atomic_store_n(&bottom, b + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    // Owner only: take the most recently pushed item
+    bool pop(T& item) {
+        uint32_t b = __atomic_load_n(&bottom, __ATOMIC_RELAXED) - 1;
+        __atomic_store_n(&bottom, b, __ATOMIC_RELAXED);
+        // bottom must be visible before top is read, or a thief and the
+        // owner could both take the last item
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        uint32_t t = __atomic_load_n(&top, __ATOMIC_RELAXED);
+
+        int32_t size = distance(t, b);
+        if (size < 0) {
+            __atomic_store_n(&bottom, b + 1, __ATOMIC_RELAXED);
+            return false;
+        }
+        item = slots[b & MASK];
+        if (size > 0) {
+            return true;
+        }
+
+        // Last item: race the thieves for it through top
+        bool won = __atomic_compare_exchange_n(&top, &t, t + 1, false,
+                                               __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+        __atomic_store_n(&bottom, b + 1, __ATOMIC_RELAXED);
+        return won;
+    }
+
+    // Any hart: take the oldest item; false if empty or another thief (or
+    // the owner) won the race for it
+    bool steal(T& item) {
+        uint32_t t = __atomic_load_n(&top, __ATOMIC_ACQUIRE);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        uint32_t b = __atomic_load_n(&bottom, __ATOMIC_ACQUIRE);
+        if (distance(t, b) <= 0) {
+            return false;
+        }
+        // The slot cannot be reused before top moves past it, so the copy
+        // is only trusted if the CAS succeeds
+        item = slots[t & MASK];
+        return __atomic_compare_exchange_n(&top, &t, t + 1, false,
+                                           __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+    }
+
+    // Snapshot; exact only when no other hart is using the deque
+    uint32_t size() const {
+        int32_t size = distance(__atomic_load_n(&top, __ATOMIC_ACQUIRE),
+                                __atomic_load_n(&bottom, __ATOMIC_ACQUIRE));
+        return size > 0 ? (uint32_t)size : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+};
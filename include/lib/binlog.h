@@ -0,0 +1,153 @@
+#pragma once
+
+#include "cstdint"
+#include <type_traits>
+#include "csr.h"
+#include "interrupt.h"
+#include "smp.h"
+#include "log_format.h"
+
+// Build option (see the Makefile): BINLOG_RAW=1 sends records to the UART
+// as binary frames instead of formatting them on the target
+#ifndef BINLOG_RAW
+#define BINLOG_RAW 0
+#endif
+
+// One LOG() call site; lives in the binlog_sites table (linker.ld), so
+// its index there is the site ID carried by every record it writes
+struct LogSite {
+    const char* format;
+};
+
+extern "C" {
+    extern const LogSite __start_binlog_sites[];
+    extern const LogSite __stop_binlog_sites[];
+}
+
+// Records written and lost, summed over every hart
+struct BinLogStats {
+    uint32_t written;
+    uint32_t dropped;       // Ring full at the call; the record was lost
+    uint32_t drained;       // Handed to the UART, as text or a raw frame
+};
+
+// Binary logging with formatting deferred off the hot path
+//
+// LOG("fmt", args...) does not format anything: it copies the site ID, the
+// low word of mcycle and each argument as one raw word into the calling
+// hart's SpscRing (layout in log_format.h), with interrupts masked for the
+// handful of stores so handlers on the same hart can log too. A full ring
+// drops the record and counts it; the caller never waits on the UART.
+//
+// Records are formatted later on hart 0, by the drain task (init()) when
+// nothing of higher priority is ready, or by flush(). Since formatting is
+// deferred, %s arguments must point at strings that outlive the drain:
+// literals and other static storage, never stack buffers.
+//
+// With BINLOG_RAW (make LOG_RAW=1) the drain skips formatting and sends the
+// records themselves as frames (log_format.h); host/trace_decode turns a
+// capture of the UART, or a memory dump of the rings, back into text
+// using the format strings in the ELF.
+//
+// Output of different harts is not interleaved by time; every record
+// carries its mcycle stamp for tools that need the order.
+class BinLog {
+public:
+    static constexpr uint32_t RING_WORDS = LogRecord::RING_WORDS;
+    static constexpr uint32_t LINE_MAX = 160;
+    static constexpr uint32_t DRAIN_BATCH = 16;
+    static constexpr uint32_t DRAIN_PERIOD_MS = 5;
+    static constexpr uint32_t DRAIN_STACK_SIZE = 2048;
+    static constexpr uint8_t DRAIN_PRIORITY = 0;
+
+    typedef SpscRing<uint32_t, RING_WORDS> LogRing;
+
+    static_assert(LogRecord::MAX_FRAME_BYTES <= LINE_MAX, "a raw frame must fit a line");
+
+    // Start the drain task (after Scheduler::init() and UartDriver::init())
+    static void init();
+
+    // Hot path behind LOG(): copy the record into this hart's ring
+    template<typename... Args>
+    static void write(const LogSite* site, Args... args) {
+        static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "too many LOG arguments");
+        uint32_t record[LogRecord::HEADER_WORDS + sizeof...(Args)] = {
+            LogRecord::header((uint32_t)(site - __start_binlog_sites), sizeof...(Args)),
+            0, arg_word(args)...
+        };
+        record[1] = csr<CSR_MCYCLE>::read();
+        commit(record, LogRecord::HEADER_WORDS + sizeof...(Args));
+    }
+
+    // Profiler sample for the timeline (PROFILE_TRACE): the probe, when
+    // its scope started and how many cycles it took
+    static void write_probe(const void* probe, uint32_t start, uint32_t cycles) {
+        uint32_t record[LogRecord::HEADER_WORDS + 2] = {
+            LogRecord::header(LogRecord::PROBE_SITE, 2), start, (uint32_t)(uintptr_t)probe, cycles
+        };
+        commit(record, LogRecord::HEADER_WORDS + 2);
+    }
+
+    // Hart 0: write out up to max_records records, stopping
+    // early when the UART TX ring can't take a whole line; returns how
+    // many were drained
+    static uint32_t drain(uint32_t max_records);
+
+    // Hart 0: drain every ring and wait for the UART to go idle. Call
+    // before writing to the UART directly so output stays in order.
+    static void flush();
+
+    // Words waiting in all rings
+    static uint32_t pending();
+
+    static BinLogStats get_stats();
+
+    static uint32_t site_count() { return (uint32_t)(__stop_binlog_sites - __start_binlog_sites); }
+
+private:
+    static LogHartBuffer harts[Smp::MAX_HARTS];
+    static uint32_t drained;
+    static char line[LINE_MAX];
+
+    template<typename T>
+    static uint32_t arg_word(T value) {
+        static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                      "LOG arguments are integers, chars or static strings");
+        static_assert(sizeof(T) <= sizeof(uint32_t), "narrow 64-bit LOG arguments first");
+        return (uint32_t)value;
+    }
+
+    static uint32_t arg_word(const char* str) { return (uint32_t)(uintptr_t)str; }
+
+    static void commit(const uint32_t* record, uint32_t words) {
+        InterruptGuard guard;
+        LogHartBuffer& log = harts[csr<CSR_MHARTID>::read()];
+        if (log.ring.try_push_batch(record, words)) {
+            log.written++;
+        } else {
+            log.dropped++;
+        }
+    }
+
+    static bool drain_one(uint32_t hart);
+    static void drain_task(void* arg);
+};
+
+#define BINLOG_STRINGIFY_(x) #x
+#define BINLOG_STRINGIFY(x) BINLOG_STRINGIFY_(x)
+
+// Log a printf-style line (conversions in log_format.h), e.g.
+//   LOG("   Map size: %u\n", map.size());
+//
+// Each site gets its own binlog_sites.<n> section, gathered into the table
+// by linker.ld: a site in an inline function is a COMDAT object, and GCC
+// rejects COMDAT and plain objects sharing one named section. A template
+// body has one section name for all its instantiations, and GCC quietly
+// drops the attribute when two meet in a file, so log from a non-template
+// helper there.
+#define LOG(format, ...) \
+    do { \
+        static const LogSite log_site_ \
+            __attribute__((section("binlog_sites." BINLOG_STRINGIFY(__COUNTER__)), used)) = {format}; \
+        BinLog::write(&log_site_, ##__VA_ARGS__); \
+    } while (0)
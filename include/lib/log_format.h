@@ -0,0 +1,71 @@
+#pragma once
+
+#include "cstddef"
+#include "cstdint"
+#include "spsc_ring.h"
+
+// Binary log record layout, shared by the firmware (lib/binlog.h) and
+// host-side tools
+//
+// A record is HEADER_WORDS + arg_count 32-bit words:
+//
+//   header      site ID << 8 | arg_count
+//   timestamp   low word of mcycle when the call was made
+//   args        one word per argument, in call order
+//
+// The site ID indexes the binlog_sites table in the ELF, whose entries
+// point at the printf-style format strings. PROBE_SITE marks a profiler
+// sample instead (PROFILE_TRACE=1): args are the ProfileProbe's address
+// and the cycles it measured, and the timestamp is the scope's start.
+//
+// In raw mode (LOG_RAW=1) the drain task sends each record over the UART
+// as-is, preceded by FRAME_SYNC | hart, all little-endian words. The sync
+// bytes never occur in text, so frames and plain output can share the
+// line and a decoder can tell them apart byte by byte.
+class LogRecord {
+public:
+    static constexpr uint32_t HEADER_WORDS = 2;
+    static constexpr uint32_t MAX_ARGS = 8;
+    static constexpr uint32_t MAX_WORDS = HEADER_WORDS + MAX_ARGS;
+    static constexpr uint32_t MAX_SITES = 1u << 24;
+    static constexpr uint32_t PROBE_SITE = MAX_SITES - 1;
+    static constexpr uint32_t RING_WORDS = 2048;
+
+    static constexpr uint32_t FRAME_SYNC = 0xB10C5E00;
+    static constexpr uint32_t FRAME_SYNC_MASK = 0xFFFFFF00;
+    static constexpr uint32_t MAX_FRAME_BYTES = 4 * (1 + MAX_WORDS);
+
+    static constexpr uint32_t header(uint32_t site, uint32_t arg_count) {
+        return site << 8 | arg_count;
+    }
+    static constexpr uint32_t site_of(uint32_t header) { return header >> 8; }
+    static constexpr uint32_t arg_count_of(uint32_t header) { return header & 0xFF; }
+};
+
+// One hart's ring as it sits in memory (BinLog's per-hart array). Only
+// 32-bit fields, so the layout is the same in the RV32 firmware and in a
+// 64-bit host tool reading a memory dump.
+struct alignas(64) LogHartBuffer {
+    SpscRing<uint32_t, LogRecord::RING_WORDS> ring;
+    uint32_t written;
+    uint32_t dropped;
+};
+
+// Maps a %s argument (a target address) to the string it points at;
+// nullptr prints as "(null)"
+typedef const char* (*LogStringResolver)(uint32_t address, void* context);
+
+// printf-style formatting of a record's raw argument words
+//
+// Conversions: %d %u %x %c %s and %%, with an optional 0 flag and field
+// width (%08x). Each conversion takes the next argument word; missing
+// arguments print as '?'. No heap, no libc, so the same code runs in the
+// firmware's drain task and in host tools.
+class LogFormatter {
+public:
+    // Format into out, always NUL-terminated and truncated to
+    // out_size - 1 characters; returns the length written
+    static size_t format(char* out, size_t out_size, const char* format,
+                         const uint32_t* args, uint32_t arg_count,
+                         LogStringResolver resolve, void* context);
+};
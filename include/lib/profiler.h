@@ -0,0 +1,155 @@
+#pragma once
+
+#include "cstdint"
+#include "csr.h"
+
+// Build options (see the Makefile): PROFILE_ENABLED=0 compiles every
+// PROFILE_SCOPE away; PROFILE_HPM_EVENT selects the event counted by
+// mhpmcounter3 (implementation defined, 0 leaves the counter unused);
+// PROFILE_TRACE=1 also logs every sample as a binary log record, for the
+// timeline host/trace_decode builds
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 1
+#endif
+#ifndef PROFILE_HPM_EVENT
+#define PROFILE_HPM_EVENT 0
+#endif
+#ifndef PROFILE_TRACE
+#define PROFILE_TRACE 0
+#endif
+
+#if PROFILE_TRACE
+#include "binlog.h"
+#endif
+
+// Per-site timing statistics with a fixed log-linear cycle histogram
+//
+// Buckets are exact below 8 cycles; above that each power of two is split
+// into four sub-buckets, so a percentile read from the histogram is within
+// 25% of the true value while the whole histogram stays a fixed 496 bytes.
+// Probes are constant-initialized (no static guard) and take a probe ID
+// from the Profiler table the first time they record. host/trace_decode
+// reads probes out of memory dumps, so keep its RV32 layout offsets in
+// step with the members below.
+//
+// record() is not reentrant: use a probe from one context only (a given
+// ISR, or the main loop), which PROFILE_SCOPE does by construction.
+class ProfileProbe {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 2;
+    static constexpr uint32_t BUCKET_COUNT = (32 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+    static constexpr uint32_t UNREGISTERED = 0xFFFFFFFF;
+
+    constexpr explicit ProfileProbe(const char* name) : name_(name) {}
+
+    void record(uint64_t cycles, uint64_t instret, uint64_t events);
+    void reset();
+
+    const char* name() const { return name_; }
+    uint32_t id() const { return id_; }
+    uint32_t count() const { return count_; }
+    uint32_t min_cycles() const { return count_ ? min_cycles_ : 0; }
+    uint32_t max_cycles() const { return max_cycles_; }
+    uint32_t avg_cycles() const { return count_ ? (uint32_t)(total_cycles_ / count_) : 0; }
+    uint32_t avg_instret() const { return count_ ? (uint32_t)(total_instret_ / count_) : 0; }
+    uint32_t avg_events() const { return count_ ? (uint32_t)(total_events_ / count_) : 0; }
+
+    // Upper bound of the bucket holding the given percentile (1-100),
+    // clamped to the observed maximum
+    uint32_t percentile_cycles(uint32_t percent) const;
+
+    static uint32_t bucket_of(uint32_t cycles);
+    static uint32_t bucket_upper(uint32_t bucket);
+
+private:
+    const char* name_;
+    uint32_t id_ = UNREGISTERED;
+    uint32_t count_ = 0;
+    uint32_t min_cycles_ = 0xFFFFFFFF;
+    uint32_t max_cycles_ = 0;
+    uint64_t total_cycles_ = 0;
+    uint64_t total_instret_ = 0;
+    uint64_t total_events_ = 0;
+    uint32_t buckets_[BUCKET_COUNT] = {};
+};
+
+// Profiling counters and the probe table
+//
+// mcycle/minstret (and mhpmcounter3 when PROFILE_HPM_EVENT is set) are
+// read as 64-bit values, so long regions don't wrap at 2^32 cycles.
+class Profiler {
+public:
+    static constexpr uint32_t MAX_PROBES = 32;
+
+    // Program mhpmevent3 and start the counters; without PROFILE_HPM_EVENT
+    // this leaves the CSRs alone (mcycle/minstret run from reset)
+    static void init();
+
+    static inline uint64_t cycles() { return csr_read64<CSR_MCYCLE, CSR_MCYCLEH>(); }
+    static inline uint64_t instret() { return csr_read64<CSR_MINSTRET, CSR_MINSTRETH>(); }
+    static inline uint64_t events() {
+#if PROFILE_HPM_EVENT
+        return csr_read64<CSR_MHPMCOUNTER3, CSR_MHPMCOUNTER3H>();
+#else
+        return 0;
+#endif
+    }
+
+    // Assign the next probe ID; UNREGISTERED once the table is full
+    // (the probe still records, it just isn't reported)
+    static uint32_t register_probe(ProfileProbe* probe);
+
+    static uint32_t probe_count() { return probe_total; }
+    static ProfileProbe* get_probe(uint32_t id) { return id < probe_total ? probes[id] : nullptr; }
+
+    // Dump count/min/avg/p99/max cycles per probe over UART
+    static void report();
+
+    // Clear every registered probe's samples
+    static void reset();
+
+private:
+    static ProfileProbe* probes[MAX_PROBES];
+    static uint32_t probe_total;
+};
+
+// RAII probe: samples the counters on construction and records the
+// deltas into the probe when the scope ends
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileProbe& probe)
+        : probe(probe), start_instret(Profiler::instret()), start_events(Profiler::events()),
+          start_cycles(Profiler::cycles()) {}
+
+    ~ProfileScope() {
+        uint64_t cycles = Profiler::cycles() - start_cycles;
+        uint64_t events = Profiler::events() - start_events;
+        uint64_t instret = Profiler::instret() - start_instret;
+        probe.record(cycles, instret, events);
+#if PROFILE_TRACE
+        BinLog::write_probe(&probe, (uint32_t)start_cycles,
+                            cycles > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)cycles);
+#endif
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileProbe& probe;
+    uint64_t start_instret;
+    uint64_t start_events;
+    uint64_t start_cycles;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Profile the rest of the enclosing scope under the given name
+#if PROFILE_ENABLED
+#define PROFILE_SCOPE(name) \
+    static ProfileProbe PROFILE_CONCAT(profile_probe_, __LINE__)(name); \
+    ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(PROFILE_CONCAT(profile_probe_, __LINE__))
+#else
+#define PROFILE_SCOPE(name) do {} while (0)
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "cstddef"
+#include "cstdint"
+
+// Size-class slab allocator for small fixed-size objects
+//
+// Objects up to MAX_OBJECT_SIZE bytes are carved from SLAB_BYTES slabs
+// obtained from global operator new and recycled through an intrusive
+// free list per size class, so allocate() and deallocate() are O(1) and
+// pay no per-object header or 8-byte rounding. Slabs are kept for reuse
+// once carved; the pool grows to the peak node count and stays there.
+// Larger requests fall through to global operator new.
+//
+// Frees must pass the allocation size (sized delete) to locate the class.
+// Not interrupt safe.
+class SlabAllocator {
+public:
+    struct ClassStats {
+        uint32_t object_size;   // Slot size of the class in bytes
+        uint32_t slab_count;    // Slabs carved for this class
+        uint32_t capacity;      // Slots across all slabs
+        uint32_t in_use;        // Slots currently allocated
+        uint32_t peak_in_use;   // High-water mark of in_use
+    };
+
+    static constexpr size_t MAX_OBJECT_SIZE = 128;
+    static constexpr size_t SLAB_BYTES = 1024;
+    static constexpr uint32_t CLASS_COUNT = 9;
+
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr, size_t size);
+
+    static ClassStats get_class_stats(uint32_t index);
+
+private:
+    struct FreeObject {
+        FreeObject* next;
+    };
+
+    struct SizeClass {
+        FreeObject* free_list;
+        uint32_t object_size;
+        uint32_t slab_count;
+        uint32_t in_use;
+        uint32_t peak_in_use;
+    };
+
+    static SizeClass classes[CLASS_COUNT];
+
+    static SizeClass* class_for(size_t size);
+    static bool refill(SizeClass& size_class);
+};
+
+// Node allocation policies for the containers
+struct SlabNodeAllocator {
+    static void* allocate(size_t size) { return SlabAllocator::allocate(size); }
+    static void deallocate(void* ptr, size_t size) { SlabAllocator::deallocate(ptr, size); }
+};
+
+struct GlobalNodeAllocator {
+    static void* allocate(size_t size) { return ::operator new(size); }
+    static void deallocate(void* ptr, size_t size) { ::operator delete(ptr, size); }
+};
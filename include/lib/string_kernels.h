@@ -0,0 +1,32 @@
+#pragma once
+
+#include "cstddef"
+#include "cstdint"
+
+// Tuned memcpy/memset/strlen (src/lib/string_kernels.cpp)
+//
+// The file defines the libc symbols themselves, so they replace musl's
+// byte-oriented versions at link time for every caller: direct calls,
+// calls the compiler emits for struct copies and builtin expansions that
+// fall back to a call. It is compiled with -fno-builtin and without loop
+// pattern distribution so the loops inside are not turned back into calls
+// to the functions being defined.
+//
+// Each routine aligns the destination (or the scan pointer) to a word,
+// then moves 32 bytes per unrolled iteration. A misaligned memcpy source
+// is read as aligned words and recombined with shifts, so no access is
+// ever misaligned. Below SMALL_SIZE bytes a plain byte loop is cheaper
+// than the setup. With RVV in use (VectorKernels::vector_enabled()),
+// memcpy and memset above VECTOR_THRESHOLD bytes and strlen use e8 vector
+// loops instead.
+class StringKernels {
+public:
+    static constexpr size_t SMALL_SIZE = 16;
+    static constexpr size_t VECTOR_THRESHOLD = 64;
+
+    // Byte-at-a-time reference versions: the baseline for the benchmarks
+    // and the host tests
+    static void* copy_bytes(void* dst, const void* src, size_t count);
+    static void* set_bytes(void* dst, int value, size_t count);
+    static size_t length_bytes(const char* str);
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "cstddef"
+#include "cstdint"
+
+// Two-Level Segregated Fit heap for baremetal environment
+//
+// Free blocks are kept in size-segregated lists indexed by a two-level
+// bitmap, so allocate() and deallocate() are O(1) regardless of how many
+// blocks exist. Every block carries a boundary tag (pointer to the
+// physically previous block) so neighbouring free blocks are coalesced
+// immediately on free.
+//
+// The heap manages any caller-supplied region and has no dependency on the
+// linker script or UART, so it also builds natively for host benchmarks.
+// It is not interrupt safe: callers must not allocate from an ISR.
+class TlsfHeap {
+public:
+    struct Stats {
+        size_t total_bytes;         // Bytes handed to init()
+        size_t used_bytes;          // Payload bytes currently allocated
+        size_t peak_used_bytes;     // High-water mark of used_bytes
+        size_t high_water_bytes;    // Furthest block end ever handed out, from region start
+        uint32_t alloc_count;       // Successful allocations
+        uint32_t free_count;        // Successful frees
+        uint32_t failed_count;      // Allocations that returned nullptr
+        uint32_t bad_free_count;    // Double frees or sized-delete mismatches
+    };
+
+    // Payload alignment and per-block header size (two pointers)
+    static constexpr size_t ALIGN_SIZE = 2 * sizeof(void*);
+
+    void init(void* start, size_t size);
+
+    void* allocate(size_t size);
+    void deallocate(void* ptr);
+
+    // Sized delete: size must not exceed the usable size of the block
+    void deallocate(void* ptr, size_t size);
+
+    // Usable payload size of an allocated block
+    static size_t usable_size(const void* ptr);
+
+    size_t get_free_memory() const { return free_bytes; }
+    size_t get_largest_free_block() const;
+    const Stats& get_stats() const { return stats; }
+
+private:
+    struct Block {
+        Block* prev_phys;       // Physically previous block, nullptr for the first
+        size_t size_flags;      // Payload size | BLOCK_FREE
+        Block* next_free;       // Free-list links, only valid while free
+        Block* prev_free;
+    };
+
+    static constexpr size_t BLOCK_FREE = 1;
+    static constexpr size_t HEADER_SIZE = offsetof(Block, next_free);
+    static constexpr size_t MIN_BLOCK_SIZE = sizeof(Block) - HEADER_SIZE;
+
+    static constexpr uint32_t ALIGN_SIZE_LOG2 = sizeof(void*) == 8 ? 4 : 3;
+    static constexpr uint32_t SL_INDEX_COUNT_LOG2 = 4;
+    static constexpr uint32_t SL_INDEX_COUNT = 1u << SL_INDEX_COUNT_LOG2;
+    static constexpr uint32_t FL_INDEX_MAX = 30;
+    static constexpr uint32_t FL_INDEX_SHIFT = SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2;
+    static constexpr uint32_t FL_INDEX_COUNT = FL_INDEX_MAX - FL_INDEX_SHIFT + 1;
+    static constexpr size_t SMALL_BLOCK_SIZE = size_t(1) << FL_INDEX_SHIFT;
+    static constexpr size_t MAX_BLOCK_SIZE = size_t(1) << FL_INDEX_MAX;
+
+    static_assert(HEADER_SIZE == ALIGN_SIZE, "block header must preserve payload alignment");
+
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[FL_INDEX_COUNT];
+    Block* free_lists[FL_INDEX_COUNT][SL_INDEX_COUNT];
+
+    uint8_t* region_start;
+    uint8_t* region_end;
+    size_t free_bytes;
+    Stats stats;
+
+    static size_t block_size(const Block* block) { return block->size_flags & ~BLOCK_FREE; }
+    static bool is_free(const Block* block) { return (block->size_flags & BLOCK_FREE) != 0; }
+    static void* to_payload(Block* block) { return reinterpret_cast<uint8_t*>(block) + HEADER_SIZE; }
+    static Block* from_payload(const void* ptr) {
+        return reinterpret_cast<Block*>(const_cast<uint8_t*>(static_cast<const uint8_t*>(ptr)) - HEADER_SIZE);
+    }
+    static Block* next_phys(Block* block) {
+        return reinterpret_cast<Block*>(static_cast<uint8_t*>(to_payload(block)) + block_size(block));
+    }
+
+    static void mapping_insert(size_t size, uint32_t& fl, uint32_t& sl);
+    static void mapping_search(size_t size, uint32_t& fl, uint32_t& sl);
+
+    Block* find_suitable(uint32_t& fl, uint32_t& sl) const;
+    void insert_free(Block* block);
+    void remove_free(Block* block);
+    Block* merge_with_next(Block* block);
+    void split(Block* block, size_t size);
+    bool owns(const void* ptr) const;
+};
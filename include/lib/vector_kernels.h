@@ -0,0 +1,49 @@
+#pragma once
+
+#include "cstddef"
+#include "cstdint"
+
+// RVV code is compiled in when the build enables the V extension
+// (make VECTOR=1, which sets ARCH=rv32imafdcv_zicsr)
+#if defined(__riscv_vector)
+#define VECTOR_KERNELS_RVV 1
+#else
+#define VECTOR_KERNELS_RVV 0
+#endif
+
+// Array kernels with an RVV path and a scalar fallback
+//
+// init() enables the vector path only if the kernels were compiled with
+// RVV and misa reports V on this hart; otherwise every kernel runs its
+// scalar loop, so a VECTOR=1 image still runs on a core without V. The
+// vector loops are strip-mined with vsetvli at LMUL=8, so any VLEN works
+// and there is no scalar tail loop.
+//
+// Vector registers are not part of any trap frame or task context, so
+// each strip runs under an InterruptGuard: a preempting task can never
+// observe or clobber another task's half-finished strip. A strip is at
+// most VLEN/4 elements, which bounds the extra interrupt latency.
+class VectorKernels {
+public:
+    static void init();
+    static bool vector_enabled() { return use_vector; }
+
+    // dst[i] = src[i] * multiplier + addend (dst may equal src)
+    static void map_affine(int32_t* dst, const int32_t* src, size_t count,
+                           int32_t multiplier, int32_t addend);
+
+    // dst[i] = value
+    static void fill(int32_t* dst, size_t count, int32_t value);
+
+    // Sum of src[i], accumulated in 64 bits
+    static int64_t sum(const int32_t* src, size_t count);
+
+    // Scalar versions, always available (baseline for the benchmarks)
+    static void map_affine_scalar(int32_t* dst, const int32_t* src, size_t count,
+                                  int32_t multiplier, int32_t addend);
+    static void fill_scalar(int32_t* dst, size_t count, int32_t value);
+    static int64_t sum_scalar(const int32_t* src, size_t count);
+
+private:
+    static bool use_vector;
+};
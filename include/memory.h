@@ -2,19 +2,22 @@
 
 #include "cstddef"
 #include "cstdint"
+#include "tlsf_heap.h"
 
-// Simple heap allocator for baremetal environment
+// Heap allocator for baremetal environment
+// Thin static facade over a TLSF heap spanning __heap_start..__heap_end.
 class SimpleAllocator {
 private:
-    static uint8_t* heap_start;
-    static uint8_t* heap_end;
-    static uint8_t* heap_current;
+    static TlsfHeap heap;
     
 public:
     static void init();
     static void* allocate(size_t size);
     static void deallocate(void* ptr);
+    static void deallocate(void* ptr, size_t size);
     static size_t get_free_memory();
+    static size_t get_largest_free_block();
+    static const TlsfHeap::Stats& get_stats();
 };
 
 // Override global new/delete operators
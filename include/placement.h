@@ -0,0 +1,27 @@
+#pragma once
+
+// Placement of hot code and data in the fast windows of ITCM and DTCM
+// (ITCM_FAST/DTCM_FAST in linker.ld)
+//
+//   HOT_CODE   function runs from ITCM_FAST; _start copies it there from
+//              its load address in ITCM before anything can call it
+//   HOT_DATA   initialized variable in DTCM_FAST, copied in the same way
+//   FAST_RAM   zero-initialized variable in DTCM_FAST, cleared with .bss;
+//              a non-zero constant initializer would be lost, use HOT_DATA
+//
+// Put them on out-of-line definitions in .cpp files: inline and template
+// functions mostly get inlined, and then run wherever their caller does.
+// Both windows are 64KB, so keep
+// them for the paths that run on every trap, switch or allocation;
+// `make size` reports how full each region is.
+//
+// Host builds compile the attributes away.
+#if defined(__riscv)
+#define HOT_CODE __attribute__((section(".fast_text")))
+#define HOT_DATA __attribute__((section(".fast_data")))
+#define FAST_RAM __attribute__((section(".fast_bss")))
+#else
+#define HOT_CODE
+#define HOT_DATA
+#define FAST_RAM
+#endif
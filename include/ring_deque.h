@@ -0,0 +1,250 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Growable ring-buffer deque for baremetal environment
+//
+// Elements live in one power-of-two sized array addressed through a head
+// index and a mask, so push/pop at either end are O(1) (amortized when the
+// buffer has to grow) and iteration walks memory instead of chasing
+// pointers. Storage is allocated once and reused: popping never frees, so
+// a FIFO that has reached its working depth stops touching the heap.
+// Same API as SimpleList plus indexed access.
+//
+// Growing invalidates pointers and iterators into the deque.
+template<typename T>
+class RingDeque {
+private:
+    T* data;
+    size_t head;        // Index of the front element
+    size_t size_;
+    size_t capacity_;   // Zero or a power of two
+
+    size_t slot(size_t index) const {
+        return (head + index) & (capacity_ - 1);
+    }
+
+    static T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    size_t grown_capacity() const {
+        return capacity_ ? capacity_ * 2 : 8;
+    }
+
+    // Move the elements into fresh, front first at index 0, and free the
+    // old buffer
+    void move_into(T* fresh, size_t new_capacity) {
+        for (size_t i = 0; i < size_; ++i) {
+            T& element = data[slot(i)];
+            new (&fresh[i]) T(std::move(element));
+            element.~T();
+        }
+        ::operator delete(static_cast<void*>(data));
+        data = fresh;
+        head = 0;
+        capacity_ = new_capacity;
+    }
+
+    void reallocate(size_t new_capacity) {
+        move_into(allocate(new_capacity), new_capacity);
+    }
+
+    void copy_from(const RingDeque& other) {
+        reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i) {
+            new (&data[i]) T(other[i]);
+        }
+        head = 0;
+        size_ = other.size_;
+    }
+
+public:
+    RingDeque() : data(nullptr), head(0), size_(0), capacity_(0) {}
+
+    ~RingDeque() {
+        clear();
+        ::operator delete(static_cast<void*>(data));
+    }
+
+    // Copy constructor
+    RingDeque(const RingDeque& other) : data(nullptr), head(0), size_(0), capacity_(0) {
+        copy_from(other);
+    }
+
+    // Move constructor: takes over the buffer
+    RingDeque(RingDeque&& other) noexcept
+        : data(other.data), head(other.head), size_(other.size_), capacity_(other.capacity_) {
+        other.data = nullptr;
+        other.head = 0;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    // Assignment operator
+    RingDeque& operator=(const RingDeque& other) {
+        if (this != &other) {
+            clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    // Move assignment operator
+    RingDeque& operator=(RingDeque&& other) noexcept {
+        if (this != &other) {
+            clear();
+            ::operator delete(static_cast<void*>(data));
+            data = other.data;
+            head = other.head;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data = nullptr;
+            other.head = 0;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    // Make room for at least count elements (rounded up to a power of two)
+    void reserve(size_t count) {
+        if (count <= capacity_) return;
+        size_t new_capacity = capacity_ ? capacity_ : 8;
+        while (new_capacity < count) {
+            new_capacity *= 2;
+        }
+        reallocate(new_capacity);
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void push_front(const T& value) {
+        emplace_front(value);
+    }
+
+    void push_front(T&& value) {
+        emplace_front(std::move(value));
+    }
+
+    // When the deque is full the new element is built in the new buffer
+    // before the old ones move across, since args may refer to one of them
+    // (q.push_back(q.front()))
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            size_t new_capacity = grown_capacity();
+            T* fresh = allocate(new_capacity);
+            T* element = new (&fresh[size_]) T(std::forward<Args>(args)...);
+            move_into(fresh, new_capacity);
+            size_++;
+            return *element;
+        }
+        T* element = new (&data[slot(size_)]) T(std::forward<Args>(args)...);
+        size_++;
+        return *element;
+    }
+
+    template<typename... Args>
+    T& emplace_front(Args&&... args) {
+        if (size_ == capacity_) {
+            // The new front goes in the last slot, wrapping round to the
+            // moved elements at index 0
+            size_t new_capacity = grown_capacity();
+            T* fresh = allocate(new_capacity);
+            T* element = new (&fresh[new_capacity - 1]) T(std::forward<Args>(args)...);
+            move_into(fresh, new_capacity);
+            head = new_capacity - 1;
+            size_++;
+            return *element;
+        }
+        size_t new_head = (head - 1) & (capacity_ - 1);
+        T* element = new (&data[new_head]) T(std::forward<Args>(args)...);
+        head = new_head;
+        size_++;
+        return *element;
+    }
+
+    void pop_back() {
+        if (!size_) return;
+        data[slot(size_ - 1)].~T();
+        size_--;
+    }
+
+    void pop_front() {
+        if (!size_) return;
+        data[head].~T();
+        head = (head + 1) & (capacity_ - 1);
+        size_--;
+    }
+
+    T& front() { return data[head]; }
+    const T& front() const { return data[head]; }
+
+    T& back() { return data[slot(size_ - 1)]; }
+    const T& back() const { return data[slot(size_ - 1)]; }
+
+    // Element at position index from the front
+    T& operator[](size_t index) { return data[slot(index)]; }
+    const T& operator[](size_t index) const { return data[slot(index)]; }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    // Destroy all elements but keep the buffer for reuse
+    void clear() {
+        for (size_t i = 0; i < size_; ++i) {
+            data[slot(i)].~T();
+        }
+        head = 0;
+        size_ = 0;
+    }
+
+    // Iterator class
+    class Iterator {
+    private:
+        RingDeque* deque;
+        size_t index;
+    public:
+        Iterator(RingDeque* owner, size_t position) : deque(owner), index(position) {}
+
+        bool operator!=(const Iterator& other) const {
+            return index != other.index;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return index == other.index;
+        }
+
+        Iterator& operator++() {
+            if (index != deque->size_) index++;
+            return *this;
+        }
+
+        Iterator& operator--() {
+            if (index) index--;
+            return *this;
+        }
+
+        T& operator*() { return (*deque)[index]; }
+        const T& operator*() const { return (*deque)[index]; }
+
+        T* operator->() { return &(*deque)[index]; }
+        const T* operator->() const { return &(*deque)[index]; }
+    };
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, size_); }
+
+    const Iterator begin() const { return Iterator(const_cast<RingDeque*>(this), 0); }
+    const Iterator end() const { return Iterator(const_cast<RingDeque*>(this), size_); }
+};
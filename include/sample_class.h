@@ -1,12 +1,16 @@
 #pragma once
 
-#include "simple_map.h"
+#include "hash_map.h"
 #include <cstdint>
 
+// Key/value store behind add_data/get_data. FlatMap<int, int> from
+// flat_map.h is a drop-in alternative when ordered iteration matters.
+typedef HashMap<int, int> DataMap;
+
 // Sample C++ class demonstrating standard C++ features
 class DataProcessor {
 private:
-    SimpleMap<int, int> data_map;
+    DataMap data_map;
     int* dynamic_array;
     size_t array_size;
     static int instance_count;
@@ -30,8 +34,13 @@ public:
     // Get data from the map
     int* get_data(int key);
     
-    // Process data using dynamic array
-    void process_array_data(const int* input, size_t input_size);
+    // Indices per parallel_for chunk in process_array_data
+    static constexpr size_t DEFAULT_GRAIN = 1024;
+    
+    // Process data using dynamic array; inputs longer than grain are
+    // split across the harts
+    void process_array_data(const int* input, size_t input_size,
+                            size_t grain = DEFAULT_GRAIN);
     
     // Get processed results
     const int* get_processed_data() const { return dynamic_array; }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <cstddef>
+#include <utility>
+#include "slab_allocator.h"
 
 // Simple doubly-linked list implementation for baremetal environment
-template<typename T>
+// Nodes come from NodeAlloc (the slab allocator by default).
+template<typename T, typename NodeAlloc = SlabNodeAllocator>
 class SimpleList {
 private:
     struct Node {
@@ -11,16 +14,40 @@ private:
         Node* next;
         Node* prev;
         
-        Node(const T& value) : data(value), next(nullptr), prev(nullptr) {}
-        
+        // Construct the element in place from the forwarded arguments
         template<typename... Args>
-        Node(Args&&... args) : data(args...), next(nullptr), prev(nullptr) {}
+        explicit Node(Args&&... args) : data(std::forward<Args>(args)...), next(nullptr), prev(nullptr) {}
+        
+        static void* operator new(size_t size) { return NodeAlloc::allocate(size); }
+        static void operator delete(void* ptr, size_t size) { NodeAlloc::deallocate(ptr, size); }
     };
     
     Node* head;
     Node* tail;
     size_t size_;
     
+    void link_back(Node* new_node) {
+        if (!head) {
+            head = tail = new_node;
+        } else {
+            tail->next = new_node;
+            new_node->prev = tail;
+            tail = new_node;
+        }
+        size_++;
+    }
+    
+    void link_front(Node* new_node) {
+        if (!head) {
+            head = tail = new_node;
+        } else {
+            new_node->next = head;
+            head->prev = new_node;
+            head = new_node;
+        }
+        size_++;
+    }
+    
 public:
     SimpleList() : head(nullptr), tail(nullptr), size_(0) {}
     
@@ -37,6 +64,12 @@ public:
         }
     }
     
+    // Move constructor: takes over the nodes, no allocation or element copy
+    SimpleList(SimpleList&& other) noexcept : head(other.head), tail(other.tail), size_(other.size_) {
+        other.head = other.tail = nullptr;
+        other.size_ = 0;
+    }
+    
     // Assignment operator
     SimpleList& operator=(const SimpleList& other) {
         if (this != &other) {
@@ -50,54 +83,47 @@ public:
         return *this;
     }
     
-    void push_back(const T& value) {
-        Node* new_node = new Node(value);
-        if (!head) {
-            head = tail = new_node;
-        } else {
-            tail->next = new_node;
-            new_node->prev = tail;
-            tail = new_node;
+    // Move assignment operator
+    SimpleList& operator=(SimpleList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head = other.head;
+            tail = other.tail;
+            size_ = other.size_;
+            other.head = other.tail = nullptr;
+            other.size_ = 0;
         }
-        size_++;
+        return *this;
+    }
+    
+    void push_back(const T& value) {
+        link_back(new Node(value));
+    }
+    
+    void push_back(T&& value) {
+        link_back(new Node(std::move(value)));
     }
     
     void push_front(const T& value) {
-        Node* new_node = new Node(value);
-        if (!head) {
-            head = tail = new_node;
-        } else {
-            new_node->next = head;
-            head->prev = new_node;
-            head = new_node;
-        }
-        size_++;
+        link_front(new Node(value));
+    }
+    
+    void push_front(T&& value) {
+        link_front(new Node(std::move(value)));
     }
     
     template<typename... Args>
-    void emplace_back(Args&&... args) {
-        Node* new_node = new Node(args...);
-        if (!head) {
-            head = tail = new_node;
-        } else {
-            tail->next = new_node;
-            new_node->prev = tail;
-            tail = new_node;
-        }
-        size_++;
+    T& emplace_back(Args&&... args) {
+        Node* new_node = new Node(std::forward<Args>(args)...);
+        link_back(new_node);
+        return new_node->data;
     }
     
     template<typename... Args>
-    void emplace_front(Args&&... args) {
-        Node* new_node = new Node(args...);
-        if (!head) {
-            head = tail = new_node;
-        } else {
-            new_node->next = head;
-            head->prev = new_node;
-            head = new_node;
-        }
-        size_++;
+    T& emplace_front(Args&&... args) {
+        Node* new_node = new Node(std::forward<Args>(args)...);
+        link_front(new_node);
+        return new_node->data;
     }
     
     void pop_back() {
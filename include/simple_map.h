@@ -1,9 +1,12 @@
 #pragma once
 
 #include <cstddef>
+#include <utility>
+#include "slab_allocator.h"
 
 // Simple map implementation for baremetal environment
-template<typename Key, typename Value>
+// Nodes come from NodeAlloc (the slab allocator by default).
+template<typename Key, typename Value, typename NodeAlloc = SlabNodeAllocator>
 class SimpleMap {
 private:
     struct Node {
@@ -11,12 +14,37 @@ private:
         Value value;
         Node* next;
         
-        Node(const Key& k, const Value& v) : key(k), value(v), next(nullptr) {}
+        // Construct the value in place from the forwarded arguments
+        template<typename... Args>
+        explicit Node(const Key& k, Args&&... args) : key(k), value(std::forward<Args>(args)...), next(nullptr) {}
+        
+        static void* operator new(size_t size) { return NodeAlloc::allocate(size); }
+        static void operator delete(void* ptr, size_t size) { NodeAlloc::deallocate(ptr, size); }
     };
     
     Node* head;
     size_t size_;
     
+    Node* find_node(const Key& key) const {
+        Node* current = head;
+        while (current) {
+            if (current->key == key) {
+                return current;
+            }
+            current = current->next;
+        }
+        return nullptr;
+    }
+    
+    template<typename... Args>
+    Node* link_new(const Key& key, Args&&... args) {
+        Node* new_node = new Node(key, std::forward<Args>(args)...);
+        new_node->next = head;
+        head = new_node;
+        size_++;
+        return new_node;
+    }
+    
 public:
     SimpleMap() : head(nullptr), size_(0) {}
     
@@ -33,6 +61,12 @@ public:
         }
     }
     
+    // Move constructor: takes over the nodes, no allocation or element copy
+    SimpleMap(SimpleMap&& other) noexcept : head(other.head), size_(other.size_) {
+        other.head = nullptr;
+        other.size_ = 0;
+    }
+    
     // Assignment operator
     SimpleMap& operator=(const SimpleMap& other) {
         if (this != &other) {
@@ -46,72 +80,63 @@ public:
         return *this;
     }
     
+    // Move assignment operator
+    SimpleMap& operator=(SimpleMap&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head = other.head;
+            size_ = other.size_;
+            other.head = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+    
     void insert(const Key& key, const Value& value) {
-        // Check if key already exists
-        Node* current = head;
-        while (current) {
-            if (current->key == key) {
-                current->value = value;
-                return;
-            }
-            current = current->next;
+        Node* existing = find_node(key);
+        if (existing) {
+            existing->value = value;
+            return;
         }
-        
-        // Create new node
-        Node* new_node = new Node(key, value);
-        new_node->next = head;
-        head = new_node;
-        size_++;
+        link_new(key, value);
     }
     
-    Value* find(const Key& key) {
-        Node* current = head;
-        while (current) {
-            if (current->key == key) {
-                return &current->value;
-            }
-            current = current->next;
+    void insert(const Key& key, Value&& value) {
+        Node* existing = find_node(key);
+        if (existing) {
+            existing->value = std::move(value);
+            return;
         }
-        return nullptr;
+        link_new(key, std::move(value));
+    }
+    
+    Value* find(const Key& key) {
+        Node* node = find_node(key);
+        return node ? &node->value : nullptr;
     }
     
     // Operator[] for map[key] = value syntax
     Value& operator[](const Key& key) {
-        // Check if key already exists
-        Node* current = head;
-        while (current) {
-            if (current->key == key) {
-                return current->value;
-            }
-            current = current->next;
+        Node* existing = find_node(key);
+        if (existing) {
+            return existing->value;
         }
         
-        // Key doesn't exist, create new node with default value
-        Node* new_node = new Node(key, Value{});
-        new_node->next = head;
-        head = new_node;
-        size_++;
-        return new_node->value;
+        // Key doesn't exist, create new node with a value-initialized value
+        return link_new(key)->value;
     }
     
     // Emplace back functionality for map
     template<typename... Args>
     void emplace_back(const Key& key, Args&&... args) {
-        // Check if key already exists
-        Node* current = head;
-        while (current) {
-            if (current->key == key) {
-                current->value = Value(args...);
-                return;
-            }
-            current = current->next;
+        Node* existing = find_node(key);
+        if (existing) {
+            existing->value = Value(std::forward<Args>(args)...);
+            return;
         }
         
-        // Create new node with constructed value
-        Node* new_node = new Node(key, Value(args...));
-        new_node->next = head;
-        head = new_node;
-        size_++;
+        // Create new node with the value constructed in place
+        link_new(key, std::forward<Args>(args)...);
     }
     
     bool erase(const Key& key) {
@@ -188,13 +213,6 @@ public:
     
     // Find method that returns iterator
     Iterator find_iter(const Key& key) {
-        Node* current = head;
-        while (current) {
-            if (current->key == key) {
-                return Iterator(current);
-            }
-            current = current->next;
-        }
-        return end();
+        return Iterator(find_node(key));
     }
 };
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Vector with inline storage for baremetal environment
+//
+// The first N elements live inside the object itself, so short sequences
+// (and SmallVectors placed on the stack or in another object) never touch
+// the heap. Past N the elements move to a heap buffer that doubles on
+// growth. Elements are contiguous, so iteration is a pointer walk.
+//
+// Growing past the current capacity invalidates pointers and iterators.
+template<typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs at least one inline element");
+
+private:
+    alignas(T) unsigned char inline_storage[N * sizeof(T)];
+    T* data;
+    size_t size_;
+    size_t capacity_;
+
+    T* inline_data() { return reinterpret_cast<T*>(inline_storage); }
+    bool is_inline() const { return data == reinterpret_cast<const T*>(inline_storage); }
+
+    void release_heap() {
+        if (!is_inline()) {
+            ::operator delete(static_cast<void*>(data));
+        }
+    }
+
+    static T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    // Move the elements into fresh and release the old heap buffer
+    void move_into(T* fresh, size_t new_capacity) {
+        for (size_t i = 0; i < size_; ++i) {
+            new (&fresh[i]) T(std::move(data[i]));
+            data[i].~T();
+        }
+        release_heap();
+        data = fresh;
+        capacity_ = new_capacity;
+    }
+
+    void reallocate(size_t new_capacity) {
+        move_into(allocate(new_capacity), new_capacity);
+    }
+
+    void copy_from(const SmallVector& other) {
+        reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i) {
+            new (&data[i]) T(other.data[i]);
+        }
+        size_ = other.size_;
+    }
+
+    // Take other's elements: steal a heap buffer, move inline ones one by one
+    void move_from(SmallVector& other) {
+        if (other.is_inline()) {
+            for (size_t i = 0; i < other.size_; ++i) {
+                new (&data[i]) T(std::move(other.data[i]));
+            }
+            size_ = other.size_;
+            other.clear();
+        } else {
+            data = other.data;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data = other.inline_data();
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+    }
+
+public:
+    SmallVector() : data(inline_data()), size_(0), capacity_(N) {}
+
+    ~SmallVector() {
+        clear();
+        release_heap();
+    }
+
+    // Copy constructor
+    SmallVector(const SmallVector& other) : data(inline_data()), size_(0), capacity_(N) {
+        copy_from(other);
+    }
+
+    // Move constructor
+    SmallVector(SmallVector&& other) noexcept : data(inline_data()), size_(0), capacity_(N) {
+        move_from(other);
+    }
+
+    // Assignment operator
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    // Move assignment operator
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            release_heap();
+            data = inline_data();
+            capacity_ = N;
+            move_from(other);
+        }
+        return *this;
+    }
+
+    void reserve(size_t count) {
+        if (count > capacity_) {
+            reallocate(count);
+        }
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    // When full, the new element is built in the new buffer before the
+    // old ones move across, since args may refer to one of them
+    // (v.push_back(v.front()))
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            T* fresh = allocate(capacity_ * 2);
+            T* element = new (&fresh[size_]) T(std::forward<Args>(args)...);
+            move_into(fresh, capacity_ * 2);
+            size_++;
+            return *element;
+        }
+        T* element = new (&data[size_]) T(std::forward<Args>(args)...);
+        size_++;
+        return *element;
+    }
+
+    void pop_back() {
+        if (!size_) return;
+        data[--size_].~T();
+    }
+
+    T& front() { return data[0]; }
+    const T& front() const { return data[0]; }
+
+    T& back() { return data[size_ - 1]; }
+    const T& back() const { return data[size_ - 1]; }
+
+    T& operator[](size_t index) { return data[index]; }
+    const T& operator[](size_t index) const { return data[index]; }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    // True while the elements still fit in the inline storage
+    bool is_small() const { return is_inline(); }
+
+    // Destroy all elements; a heap buffer is kept for reuse
+    void clear() {
+        for (size_t i = 0; i < size_; ++i) {
+            data[i].~T();
+        }
+        size_ = 0;
+    }
+
+    // Iterator class
+    class Iterator {
+    private:
+        T* current;
+    public:
+        Iterator(T* element) : current(element) {}
+
+        bool operator!=(const Iterator& other) const {
+            return current != other.current;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return current == other.current;
+        }
+
+        Iterator& operator++() {
+            current++;
+            return *this;
+        }
+
+        Iterator& operator--() {
+            current--;
+            return *this;
+        }
+
+        T& operator*() { return *current; }
+        const T& operator*() const { return *current; }
+
+        T* operator->() { return current; }
+        const T* operator->() const { return current; }
+    };
+
+    Iterator begin() { return Iterator(data); }
+    Iterator end() { return Iterator(data + size_); }
+
+    const Iterator begin() const { return Iterator(data); }
+    const Iterator end() const { return Iterator(data + size_); }
+};
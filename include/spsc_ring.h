@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Wait-free single-producer/single-consumer ring for baremetal environment
+//
+// Hands data from exactly one producer (typically an interrupt handler) to
+// exactly one consumer (typically the main loop) without disabling
+// interrupts. head and tail are free-running 32-bit counters owned by the
+// consumer and producer respectively; each side only loads the other's
+// counter with acquire ordering and publishes its own with release
+// ordering, so on RV32 every operation is plain loads/stores plus fences
+// (no LR/SC retry loop) and finishes in bounded time.
+//
+// Capacity must be a power of two; all Capacity slots are usable. T is
+// copied by assignment, so keep it small and trivially copyable.
+template<typename T, uint32_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+private:
+    static constexpr uint32_t MASK = Capacity - 1;
+    static constexpr size_t CACHE_LINE = 64;
+
+    // Producer and consumer counters on separate lines so the two sides
+    // do not invalidate each other's cache on every operation
+    alignas(CACHE_LINE) uint32_t tail;   // Next slot to write, producer owned
+    alignas(CACHE_LINE) uint32_t head;   // Next slot to read, consumer owned
+    alignas(CACHE_LINE) T slots[Capacity];
+
+    static uint32_t load_acquire(const uint32_t& counter) {
+        return __atomic_load_n(&counter, __ATOMIC_ACQUIRE);
+    }
+
+    static uint32_t load_relaxed(const uint32_t& counter) {
+        return __atomic_load_n(&counter, __ATOMIC_RELAXED);
+    }
+
+    static void store_release(uint32_t& counter, uint32_t value) {
+        __atomic_store_n(&counter, value, __ATOMIC_RELEASE);
+    }
+
+public:
+    constexpr SpscRing() : tail(0), head(0), slots{} {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side: false if the ring is full
+    bool try_push(const T& item) {
+        uint32_t t = load_relaxed(tail);
+        if (t - load_acquire(head) == Capacity) {
+            return false;
+        }
+        slots[t & MASK] = item;
+        store_release(tail, t + 1);
+        return true;
+    }
+
+    // Producer side: push up to count items, returns how many were pushed.
+    // The whole batch is published with a single release store.
+    uint32_t push_batch(const T* items, uint32_t count) {
+        uint32_t t = load_relaxed(tail);
+        uint32_t room = Capacity - (t - load_acquire(head));
+        if (count > room) {
+            count = room;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            slots[(t + i) & MASK] = items[i];
+        }
+        if (count) {
+            store_release(tail, t + count);
+        }
+        return count;
+    }
+
+    // Producer side: push all count items or none; false if the ring
+    // lacks room. Lets variable-length records share the ring without the
+    // consumer ever seeing half of one.
+    bool try_push_batch(const T* items, uint32_t count) {
+        uint32_t t = load_relaxed(tail);
+        if (Capacity - (t - load_acquire(head)) < count) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            slots[(t + i) & MASK] = items[i];
+        }
+        store_release(tail, t + count);
+        return true;
+    }
+
+    // Consumer side: false if the ring is empty
+    bool try_pop(T& item) {
+        uint32_t h = load_relaxed(head);
+        if (load_acquire(tail) == h) {
+            return false;
+        }
+        item = slots[h & MASK];
+        store_release(head, h + 1);
+        return true;
+    }
+
+    // Consumer side: pop up to max_count items, returns how many were popped
+    uint32_t pop_batch(T* items, uint32_t max_count) {
+        uint32_t h = load_relaxed(head);
+        uint32_t available = load_acquire(tail) - h;
+        if (max_count > available) {
+            max_count = available;
+        }
+        for (uint32_t i = 0; i < max_count; ++i) {
+            items[i] = slots[(h + i) & MASK];
+        }
+        if (max_count) {
+            store_release(head, h + max_count);
+        }
+        return max_count;
+    }
+
+    // Snapshot only: exact when called by the producer or the consumer
+    // while the other side is idle
+    uint32_t size() const { return load_acquire(tail) - load_acquire(head); }
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() == Capacity; }
+    static constexpr uint32_t capacity() { return Capacity; }
+};
@@ -1,42 +1,57 @@
 #include <cstdint>
+#include "uart_driver.h"
 
 // Simple UART functions for output
+// Once UartDriver::init() has run, output goes through its interrupt-driven
+// TX ring; before that it polls the UART directly.
 namespace uart {
     constexpr uint64_t UART_BASE = 0x10000000;
     constexpr uint64_t UART_THR = UART_BASE + 0x00;
     constexpr uint64_t UART_LSR = UART_BASE + 0x05;
     
-    static void putchar(char c) {
+    static inline void putchar(char c) {
+        if (UartDriver::is_enabled()) {
+            UartDriver::write_all(&c, 1);
+            return;
+        }
         while ((*(volatile uint8_t*)UART_LSR & 0x20) == 0) {}
         *(volatile uint8_t*)UART_THR = c;
     }
     
-    static void puts(const char* str) {
-        while (*str) {
-            putchar(*str++);
+    static inline void write(const char* buf, size_t len) {
+        if (UartDriver::is_enabled()) {
+            UartDriver::write_all(buf, len);
+            return;
+        }
+        while (len--) {
+            putchar(*buf++);
         }
     }
     
-    static void print_number(uint32_t num) {
-        if (num == 0) {
-            putchar('0');
-            return;
-        }
-        
+    static inline void puts(const char* str) {
+        size_t len = 0;
+        while (str[len]) len++;
+        write(str, len);
+    }
+    
+    // Digits are built back to front and written in one call, so the
+    // buffered driver takes them as a single batch
+    static inline void print_number(uint32_t num) {
+        char buffer[10];
+        size_t i = sizeof(buffer);
+        do {
+            buffer[--i] = '0' + (num % 10);
+            num /= 10;
+        } while (num > 0);
+        write(buffer + i, sizeof(buffer) - i);
+    }
+    
+    static inline void print_number(int32_t num) {
         if (num < 0) {
             putchar('-');
-            num = -num;
-        }
-        
-        char buffer[16];
-        int i = 0;
-        while (num > 0) {
-            buffer[i++] = '0' + (num % 10);
-            num /= 10;
-        }
-        
-        while (i > 0) {
-            putchar(buffer[--i]);
+            print_number(0u - (uint32_t)num);
+            return;
         }
+        print_number((uint32_t)num);
     }
 }
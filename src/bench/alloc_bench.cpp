@@ -0,0 +1,51 @@
+#include "bench.h"
+#include "memory.h"
+#include "slab_allocator.h"
+
+static constexpr uint32_t BLOCKS = 32;
+
+static void* blocks[BLOCKS];
+
+BENCHMARK(tlsf_alloc_free_32, BLOCKS, 0) {
+    for (uint32_t i = 0; i < BLOCKS; i++) {
+        blocks[i] = SimpleAllocator::allocate(32);
+    }
+    bench_clobber();
+    for (uint32_t i = 0; i < BLOCKS; i++) {
+        SimpleAllocator::deallocate(blocks[i], 32);
+    }
+}
+
+// Sizes from 16 to 1 KB, freed in a different order than allocated
+BENCHMARK(tlsf_alloc_free_mixed, BLOCKS, 0) {
+    for (uint32_t i = 0; i < BLOCKS; i++) {
+        blocks[i] = SimpleAllocator::allocate(16u << (i % 7));
+    }
+    bench_clobber();
+    for (uint32_t i = 0; i < BLOCKS; i += 2) {
+        SimpleAllocator::deallocate(blocks[i]);
+    }
+    for (uint32_t i = 1; i < BLOCKS; i += 2) {
+        SimpleAllocator::deallocate(blocks[i]);
+    }
+}
+
+BENCHMARK(slab_alloc_free_16, BLOCKS, 0) {
+    for (uint32_t i = 0; i < BLOCKS; i++) {
+        blocks[i] = SlabAllocator::allocate(16);
+    }
+    bench_clobber();
+    for (uint32_t i = 0; i < BLOCKS; i++) {
+        SlabAllocator::deallocate(blocks[i], 16);
+    }
+}
+
+BENCHMARK(new_delete_64, BLOCKS, 0) {
+    for (uint32_t i = 0; i < BLOCKS; i++) {
+        blocks[i] = new uint8_t[64];
+    }
+    bench_clobber();
+    for (uint32_t i = 0; i < BLOCKS; i++) {
+        delete[] (uint8_t*)blocks[i];
+    }
+}
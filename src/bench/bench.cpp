@@ -0,0 +1,127 @@
+#include "bench.h"
+#include "csr.h"
+#include "uart.h"
+#include "uart_driver.h"
+
+// Static member definitions
+Benchmark* Benchmark::head = nullptr;
+Benchmark* Benchmark::tail = nullptr;
+uint32_t Benchmark::overhead_cycles = 0xFFFFFFFF;
+
+// Per-iteration samples; one benchmark runs at a time
+static uint32_t samples[Benchmark::MAX_ITERATIONS];
+
+static void empty_iteration() {
+    bench_clobber();
+}
+
+// One iteration fits comfortably in 32 bits, and the unsigned difference
+// is correct across a wrap of the low half, so mcycleh is not needed here
+static inline uint32_t time_iteration(BenchFunction function) {
+    uint32_t start = csr<CSR_MCYCLE>::read();
+    function();
+    return csr<CSR_MCYCLE>::read() - start;
+}
+
+Benchmark::Benchmark(const char* name, BenchFunction function, uint32_t ops_per_iteration,
+                     uint32_t bytes_per_iteration, uint32_t iterations)
+    : name_(name), function(function), ops_per_iteration(ops_per_iteration),
+      bytes_per_iteration(bytes_per_iteration),
+      iterations(iterations > MAX_ITERATIONS ? MAX_ITERATIONS : (iterations ? iterations : 1)),
+      next_(nullptr) {
+    if (tail) {
+        tail->next_ = this;
+    } else {
+        head = this;
+    }
+    tail = this;
+}
+
+uint32_t Benchmark::overhead() {
+    if (overhead_cycles == 0xFFFFFFFF) {
+        for (uint32_t i = 0; i < 32; i++) {
+            uint32_t cycles = time_iteration(empty_iteration);
+            if (cycles < overhead_cycles) overhead_cycles = cycles;
+        }
+    }
+    return overhead_cycles;
+}
+
+BenchStats Benchmark::run() const {
+    uint32_t correction = overhead();
+
+    for (uint32_t i = 0; i < DEFAULT_WARMUP; i++) {
+        function();
+    }
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint32_t cycles = time_iteration(function);
+        samples[i] = cycles > correction ? cycles - correction : 0;
+    }
+
+    // Insertion sort: at most MAX_ITERATIONS samples, mostly near-sorted
+    for (uint32_t i = 1; i < iterations; i++) {
+        uint32_t value = samples[i];
+        uint32_t j = i;
+        while (j > 0 && samples[j - 1] > value) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = value;
+    }
+
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        total += samples[i];
+    }
+
+    BenchStats stats;
+    stats.iterations = iterations;
+    stats.min = samples[0];
+    stats.median = samples[iterations / 2];
+    stats.mean = (uint32_t)(total / iterations);
+    stats.p99 = samples[(iterations * 99 + 99) / 100 - 1];
+    stats.max = samples[iterations - 1];
+    return stats;
+}
+
+void Benchmark::print(const BenchStats& stats) const {
+    uart::puts("BENCH name=");
+    uart::puts(name_);
+    uart::puts(" iters=");
+    uart::print_number(stats.iterations);
+    uart::puts(" min=");
+    uart::print_number(stats.min);
+    uart::puts(" median=");
+    uart::print_number(stats.median);
+    uart::puts(" mean=");
+    uart::print_number(stats.mean);
+    uart::puts(" p99=");
+    uart::print_number(stats.p99);
+    uart::puts(" max=");
+    uart::print_number(stats.max);
+    uart::puts(" ops=");
+    uart::print_number(ops_per_iteration);
+    uart::puts(" bytes=");
+    uart::print_number(bytes_per_iteration);
+    uart::puts(" ops_per_kcycle=");
+    uart::print_number(stats.median ? (uint32_t)((uint64_t)ops_per_iteration * 1000 / stats.median) : 0);
+    uart::puts("\n");
+}
+
+uint32_t Benchmark::run_all() {
+    uart::puts("BENCH_OVERHEAD cycles=");
+    uart::print_number(overhead());
+    uart::puts("\n");
+
+    uint32_t count = 0;
+    for (const Benchmark* bench = head; bench; bench = bench->next_) {
+        // Drain queued output first so TX interrupts don't land in the
+        // timed iterations
+        UartDriver::flush();
+        BenchStats stats = bench->run();
+        UartDriver::flush();
+        bench->print(stats);
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,48 @@
+#include "bench.h"
+#include "boot.h"
+#include "memory.h"
+#include "interrupt.h"
+#include "plic.h"
+#include "clint_timer.h"
+#include "uart.h"
+#include "uart_driver.h"
+#include "smp.h"
+#include "vector_kernels.h"
+
+// QEMU virt test device: a write ends the emulation, so `make bench` runs
+// headless and returns to the shell
+#define QEMU_TEST_DEVICE    0x00100000
+#define QEMU_TEST_PASS      0x5555
+
+static void qemu_exit() {
+    *(volatile uint32_t*)QEMU_TEST_DEVICE = QEMU_TEST_PASS;
+}
+
+// Entry point of the benchmark ELF (replaces src/main.cpp)
+extern "C" int main() {
+    SimpleAllocator::init();
+    InterruptController::init();
+    Plic::init();
+    UartDriver::init();
+    ClintTimer::init();
+    Smp::init();
+    InterruptController::enable_global_interrupts();
+
+    VectorKernels::init();
+
+    uart::puts("BENCH_BEGIN harts=");
+    uart::print_number(Smp::hart_count());
+    uart::puts(" rvv=");
+    uart::print_number(VectorKernels::vector_enabled());
+    uart::puts(" boot_cycles=");
+    uart::print_number(boot_timing.to_main_cycles);
+    uart::puts("\n");
+    uint32_t count = Benchmark::run_all();
+    uart::puts("BENCH_END count=");
+    uart::print_number(count);
+    uart::puts("\n");
+
+    UartDriver::flush();
+    qemu_exit();
+    return 0;
+}
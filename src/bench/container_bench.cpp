@@ -0,0 +1,63 @@
+#include "bench.h"
+#include "simple_map.h"
+#include "simple_list.h"
+
+static constexpr uint32_t ELEMENTS = 64;
+
+BENCHMARK(simple_map_insert, ELEMENTS, 0) {
+    SimpleMap<uint32_t, uint32_t> map;
+    for (uint32_t i = 0; i < ELEMENTS; i++) {
+        map.insert(i, i);
+    }
+    bench_keep(map);
+}
+
+BENCHMARK(simple_map_lookup, ELEMENTS, 0) {
+    static SimpleMap<uint32_t, uint32_t> map;
+    if (map.size() == 0) {
+        for (uint32_t i = 0; i < ELEMENTS; i++) {
+            map.insert(i, i);
+        }
+    }
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < ELEMENTS; i++) {
+        sum += *map.find(i);
+    }
+    bench_keep(sum);
+}
+
+BENCHMARK(simple_map_erase, ELEMENTS, 0) {
+    SimpleMap<uint32_t, uint32_t> map;
+    for (uint32_t i = 0; i < ELEMENTS; i++) {
+        map.insert(i, i);
+    }
+    for (uint32_t i = 0; i < ELEMENTS; i++) {
+        map.erase(i);
+    }
+    bench_keep(map);
+}
+
+BENCHMARK(simple_list_push_pop, ELEMENTS, 0) {
+    SimpleList<uint32_t> list;
+    for (uint32_t i = 0; i < ELEMENTS; i++) {
+        list.push_back(i);
+    }
+    while (list.size()) {
+        list.pop_front();
+    }
+    bench_keep(list);
+}
+
+BENCHMARK(simple_list_iterate, ELEMENTS, 0) {
+    static SimpleList<uint32_t> list;
+    if (list.size() == 0) {
+        for (uint32_t i = 0; i < ELEMENTS; i++) {
+            list.push_back(i);
+        }
+    }
+    uint32_t sum = 0;
+    for (SimpleList<uint32_t>::Iterator it = list.begin(); it != list.end(); ++it) {
+        sum += *it;
+    }
+    bench_keep(sum);
+}
@@ -0,0 +1,30 @@
+#include "bench.h"
+#include "binlog.h"
+#include "uart.h"
+
+// Cost of one status line at the call site: the uart::puts/print_number
+// chain main.cpp used before binary logging, against LOG(), which only
+// stores the record. log_format is what the drain task later spends
+// turning the same record into text, off the caller's path.
+
+static volatile uint32_t value = 12345;
+
+// 16 lines overflow the 512-byte TX ring, so the later iterations include
+// backpressure waits, as a burst of status lines did
+BENCHMARK_ITERATIONS(log_uart_chain, 1, 0, 16) {
+    uart::puts("   log bench: map size ");
+    uart::print_number(value);
+    uart::puts("\n");
+}
+
+// The records are never drained here; the ring holds every iteration
+BENCHMARK(log_binary, 1, 0) {
+    LOG("   log bench: map size %u\n", value);
+}
+
+BENCHMARK(log_format, 1, 0) {
+    static char line[BinLog::LINE_MAX];
+    uint32_t args[1] = {value};
+    LogFormatter::format(line, sizeof(line), "   log bench: map size %u\n", args, 1, nullptr, nullptr);
+    bench_keep(line);
+}
@@ -0,0 +1,60 @@
+#include "bench.h"
+#include "parallel.h"
+#include "sample_class.h"
+
+// Scaling of parallel_for from 1 to 4 harts. Each benchmark caps the
+// concurrency first; with fewer harts online the higher counts just
+// repeat the largest available. Run with several harts and without
+// -icount, which serializes the harts, to see the speedup:
+//
+//   make bench BENCH_SMP=4 BENCH_QEMU_FLAGS=
+
+static constexpr uint32_t ELEMENTS = 16384;
+static constexpr uint32_t COMPUTE_ROUNDS = 32;
+
+static int input[ELEMENTS];
+static uint32_t words[ELEMENTS];
+
+// DataProcessor allocates, so create it on first use, after the heap is up
+static DataProcessor& processor() {
+    static DataProcessor* instance = nullptr;
+    if (!instance) {
+        instance = new DataProcessor(ELEMENTS);
+        for (uint32_t i = 0; i < ELEMENTS; i++) {
+            input[i] = (int)i;
+        }
+    }
+    return *instance;
+}
+
+static void process_array(uint32_t harts) {
+    set_parallel_concurrency(harts);
+    processor().process_array_data(input, ELEMENTS);
+    bench_keep(processor().get_processed_data()[ELEMENTS - 1]);
+    set_parallel_concurrency(0);
+}
+
+// CPU-bound per element, so scaling is not limited by memory traffic
+static void compute(uint32_t harts) {
+    set_parallel_concurrency(harts);
+    parallel_for(0, ELEMENTS, 512, [](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            uint32_t x = words[i] | 1;
+            for (uint32_t round = 0; round < COMPUTE_ROUNDS; round++) {
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+            }
+            words[i] = x;
+        }
+    });
+    bench_clobber();
+    set_parallel_concurrency(0);
+}
+
+BENCHMARK_ITERATIONS(process_array_data_1h, ELEMENTS, ELEMENTS * 8, 16) { process_array(1); }
+BENCHMARK_ITERATIONS(process_array_data_2h, ELEMENTS, ELEMENTS * 8, 16) { process_array(2); }
+BENCHMARK_ITERATIONS(process_array_data_4h, ELEMENTS, ELEMENTS * 8, 16) { process_array(4); }
+BENCHMARK_ITERATIONS(parallel_for_compute_1h, ELEMENTS, 0, 16) { compute(1); }
+BENCHMARK_ITERATIONS(parallel_for_compute_2h, ELEMENTS, 0, 16) { compute(2); }
+BENCHMARK_ITERATIONS(parallel_for_compute_4h, ELEMENTS, 0, 16) { compute(4); }
@@ -0,0 +1,82 @@
+#include "bench.h"
+#include "string_kernels.h"
+#include <cstring>
+
+// Size sweep of the string kernels (which replace libc's memcpy/memset/
+// strlen) from 1 B to 64 KB, with byte-loop baselines at a few sizes.
+// bytes= is the work per iteration, so bytes/cycle = bytes / median.
+// Sizes are hidden from the optimizer so every size really calls the
+// kernel instead of an inline expansion.
+
+static constexpr size_t MAX_BYTES = 64 * 1024;
+
+static uint8_t source[MAX_BYTES + 8] __attribute__((aligned(8)));
+static uint8_t destination[MAX_BYTES + 8] __attribute__((aligned(8)));
+
+template<size_t Bytes>
+static inline size_t opaque_size() {
+    size_t bytes = Bytes;
+    asm volatile ("" : "+r" (bytes));
+    return bytes;
+}
+
+template<size_t Bytes, size_t DstOffset, size_t SrcOffset>
+static inline void copy() {
+    bench_clobber();
+    memcpy(destination + DstOffset, source + SrcOffset, opaque_size<Bytes>());
+    bench_clobber();
+}
+
+template<size_t Bytes>
+static inline void set() {
+    bench_clobber();
+    memset(destination, 0x5A, opaque_size<Bytes>());
+    bench_clobber();
+}
+
+// NUL-terminated string of the given length, built on first use
+template<size_t Length>
+static const char* string_of_length() {
+    static char text[Length + 1] __attribute__((aligned(8)));
+    if (!text[0] && Length) {
+        memset(text, 'a', Length);
+        text[Length] = '\0';
+    }
+    return text;
+}
+
+#define STRING_SWEEP(name, bytes) \
+    BENCHMARK(memcpy_##name, 1, bytes) { copy<bytes, 0, 0>(); } \
+    BENCHMARK(memcpy_unaligned_##name, 1, bytes) { copy<bytes, 1, 3>(); } \
+    BENCHMARK(memset_##name, 1, bytes) { set<bytes>(); }
+
+STRING_SWEEP(1, 1)
+STRING_SWEEP(4, 4)
+STRING_SWEEP(16, 16)
+STRING_SWEEP(64, 64)
+STRING_SWEEP(256, 256)
+STRING_SWEEP(1k, 1024)
+STRING_SWEEP(4k, 4096)
+STRING_SWEEP(16k, 16384)
+STRING_SWEEP(64k, 65536)
+
+BENCHMARK(strlen_16, 1, 16) { bench_keep(strlen(string_of_length<16>())); }
+BENCHMARK(strlen_256, 1, 256) { bench_keep(strlen(string_of_length<256>())); }
+BENCHMARK(strlen_4k, 1, 4096) { bench_keep(strlen(string_of_length<4096>())); }
+
+// Byte loops: what the generic per-byte approach costs at the same sizes
+BENCHMARK(memcpy_bytes_256, 1, 256) {
+    StringKernels::copy_bytes(destination, source, 256);
+    bench_clobber();
+}
+BENCHMARK(memcpy_bytes_4k, 1, 4096) {
+    StringKernels::copy_bytes(destination, source, 4096);
+    bench_clobber();
+}
+BENCHMARK(memset_bytes_4k, 1, 4096) {
+    StringKernels::set_bytes(destination, 0x5A, 4096);
+    bench_clobber();
+}
+BENCHMARK(strlen_bytes_4k, 1, 4096) {
+    bench_keep(StringKernels::length_bytes(string_of_length<4096>()));
+}
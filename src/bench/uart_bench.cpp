@@ -0,0 +1,17 @@
+#include "bench.h"
+#include "uart_driver.h"
+
+// One full line, so the payload doesn't split the BENCH result lines
+static const char payload[] =
+    "uart bench payload 0123456789abcdefghijklmnopqrstuvwxyz......\n";
+static constexpr uint32_t PAYLOAD_BYTES = sizeof(payload) - 1;
+
+BENCHMARK_ITERATIONS(uart_write_polled, 1, PAYLOAD_BYTES, 16) {
+    UartDriver::write_polled(payload, PAYLOAD_BYTES);
+}
+
+// Enqueue cost while the TX ring has room; 16 lines overflow the 512-byte
+// ring, so the later iterations include backpressure waits
+BENCHMARK_ITERATIONS(uart_write_buffered, 1, PAYLOAD_BYTES, 16) {
+    UartDriver::write_all(payload, PAYLOAD_BYTES);
+}
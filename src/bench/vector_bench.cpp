@@ -0,0 +1,39 @@
+#include "bench.h"
+#include "vector_kernels.h"
+
+// Dispatched kernels (RVV when VectorKernels::vector_enabled()) against
+// the scalar loops on the same data; compare ops_per_kcycle, which is
+// elements per 1000 cycles. Build with make VECTOR=1 for the RVV path.
+
+static constexpr uint32_t ELEMENTS = 4096;
+
+static int32_t source[ELEMENTS];
+static int32_t destination[ELEMENTS];
+
+BENCHMARK(map_affine_scalar, ELEMENTS, ELEMENTS * 8) {
+    VectorKernels::map_affine_scalar(destination, source, ELEMENTS, 2, 1);
+    bench_clobber();
+}
+
+BENCHMARK(map_affine, ELEMENTS, ELEMENTS * 8) {
+    VectorKernels::map_affine(destination, source, ELEMENTS, 2, 1);
+    bench_clobber();
+}
+
+BENCHMARK(fill_scalar, ELEMENTS, ELEMENTS * 4) {
+    VectorKernels::fill_scalar(destination, ELEMENTS, 0);
+    bench_clobber();
+}
+
+BENCHMARK(fill, ELEMENTS, ELEMENTS * 4) {
+    VectorKernels::fill(destination, ELEMENTS, 0);
+    bench_clobber();
+}
+
+BENCHMARK(sum_scalar, ELEMENTS, ELEMENTS * 4) {
+    bench_keep(VectorKernels::sum_scalar(source, ELEMENTS));
+}
+
+BENCHMARK(sum, ELEMENTS, ELEMENTS * 4) {
+    bench_keep(VectorKernels::sum(source, ELEMENTS));
+}
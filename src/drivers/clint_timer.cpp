@@ -0,0 +1,173 @@
+#include "clint_timer.h"
+#include "interrupt.h"
+
+#define MTIME_NEVER     0xFFFFFFFFFFFFFFFFull
+
+// Static member definitions
+ClintTimer::Timer ClintTimer::timers[MAX_TIMERS];
+uint8_t ClintTimer::heap[MAX_TIMERS];
+uint32_t ClintTimer::heap_size = 0;
+uint64_t ClintTimer::programmed = MTIME_NEVER;
+TimerStats ClintTimer::stats = {0, 0, 0, 0, 0};
+
+void ClintTimer::init() {
+    for (uint32_t i = 0; i < MAX_TIMERS; i++) {
+        timers[i].heap_index = NOT_QUEUED;
+        timers[i].generation = 0;
+    }
+    heap_size = 0;
+
+    // Nothing scheduled yet: park mtimecmp so the interrupt stays quiet
+    write_mtimecmp(MTIME_NEVER);
+    InterruptController::enable_machine_timer_interrupt();
+}
+
+uint64_t ClintTimer::now() {
+    // Re-read the high half to catch a carry out of the low half
+    volatile uint32_t* mtime = (volatile uint32_t*)CLINT_MTIME;
+    uint32_t hi;
+    uint32_t lo;
+    do {
+        hi = mtime[1];
+        lo = mtime[0];
+    } while (hi != mtime[1]);
+    return ((uint64_t)hi << 32) | lo;
+}
+
+TimerId ClintTimer::schedule_at(uint64_t deadline, TimerCallback callback, void* context) {
+    InterruptGuard guard;
+
+    uint32_t slot = 0;
+    while (slot < MAX_TIMERS && timers[slot].heap_index != NOT_QUEUED) {
+        slot++;
+    }
+    if (slot == MAX_TIMERS) {
+        stats.schedule_failures++;
+        return 0;
+    }
+
+    Timer& timer = timers[slot];
+    timer.deadline = deadline;
+    timer.callback = callback;
+    timer.context = context;
+    timer.generation = (timer.generation + 1) & 0xFFFFFF;
+    if (!timer.generation) timer.generation = 1;
+
+    place(heap_size, slot);
+    heap_size++;
+    sift_up(timer.heap_index);
+    program_next();
+
+    return (timer.generation << 8) | slot;
+}
+
+TimerId ClintTimer::schedule_after(uint64_t ticks, TimerCallback callback, void* context) {
+    return schedule_at(now() + ticks, callback, context);
+}
+
+bool ClintTimer::cancel(TimerId id) {
+    uint32_t slot = id & 0xFF;
+    if (!id || slot >= MAX_TIMERS) return false;
+
+    InterruptGuard guard;
+    Timer& timer = timers[slot];
+    if (timer.heap_index == NOT_QUEUED || timer.generation != (id >> 8)) {
+        return false;
+    }
+    remove_at(timer.heap_index);
+    stats.cancelled++;
+    program_next();
+    return true;
+}
+
+uint64_t ClintTimer::next_deadline() {
+    InterruptGuard guard;
+    return heap_size ? timers[heap[0]].deadline : MTIME_NEVER;
+}
+
+void ClintTimer::handle_interrupt() {
+    stats.interrupts++;
+
+    // Fire everything that is due, including timers that come due while
+    // earlier callbacks run
+    while (heap_size && timers[heap[0]].deadline <= now()) {
+        Timer& timer = timers[heap[0]];
+        TimerCallback callback = timer.callback;
+        void* context = timer.context;
+        remove_at(0);
+        stats.fired++;
+        callback(context);
+    }
+
+    // A deadline that passes before this write still raises the interrupt,
+    // since the CLINT compares mtime >= mtimecmp continuously
+    program_next();
+}
+
+// Spec sequence for RV32: park the low half at its maximum so the
+// intermediate value is never earlier than both the old and new deadline
+void ClintTimer::write_mtimecmp(uint64_t value) {
+    volatile uint32_t* mtimecmp = (volatile uint32_t*)CLINT_MTIMECMP_HART0;
+    mtimecmp[0] = 0xFFFFFFFF;
+    mtimecmp[1] = (uint32_t)(value >> 32);
+    mtimecmp[0] = (uint32_t)value;
+    programmed = value;
+    stats.reprograms++;
+}
+
+// Point mtimecmp at the earliest deadline (tickless: no periodic tick)
+void ClintTimer::program_next() {
+    uint64_t target = heap_size ? timers[heap[0]].deadline : MTIME_NEVER;
+    if (target != programmed) {
+        write_mtimecmp(target);
+    }
+}
+
+bool ClintTimer::earlier(uint32_t a, uint32_t b) {
+    return timers[heap[a]].deadline < timers[heap[b]].deadline;
+}
+
+void ClintTimer::place(uint32_t index, uint8_t slot) {
+    heap[index] = slot;
+    timers[slot].heap_index = index;
+}
+
+void ClintTimer::sift_up(uint32_t index) {
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (!earlier(index, parent)) break;
+        uint8_t slot = heap[index];
+        place(index, heap[parent]);
+        place(parent, slot);
+        index = parent;
+    }
+}
+
+void ClintTimer::sift_down(uint32_t index) {
+    for (;;) {
+        uint32_t smallest = index;
+        uint32_t left = 2 * index + 1;
+        uint32_t right = left + 1;
+        if (left < heap_size && earlier(left, smallest)) smallest = left;
+        if (right < heap_size && earlier(right, smallest)) smallest = right;
+        if (smallest == index) break;
+        uint8_t slot = heap[index];
+        place(index, heap[smallest]);
+        place(smallest, slot);
+        index = smallest;
+    }
+}
+
+// Remove heap[index] and free its slot
+void ClintTimer::remove_at(uint32_t index) {
+    timers[heap[index]].heap_index = NOT_QUEUED;
+    heap_size--;
+    if (index == heap_size) return;
+
+    place(index, heap[heap_size]);
+    if (index > 0 && earlier(index, (index - 1) / 2)) {
+        sift_up(index);
+    } else {
+        sift_down(index);
+    }
+}
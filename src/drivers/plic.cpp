@@ -0,0 +1,113 @@
+#include "plic.h"
+#include "interrupt.h"
+
+static inline volatile uint32_t& plic_reg(uint32_t address) {
+    return *(volatile uint32_t*)address;
+}
+
+static inline bool valid_source(uint32_t source) {
+    return source != 0 && source < PLIC_MAX_SOURCES;
+}
+
+// Static member definitions
+Plic::Registration Plic::handlers[PLIC_MAX_SOURCES];
+
+void Plic::init() {
+    for (uint32_t word = 0; word < PLIC_MAX_SOURCES / 32; word++) {
+        plic_reg(PLIC_ENABLE_M_HART0 + 4 * word) = 0;
+    }
+    set_threshold(0);
+    InterruptController::enable_machine_external_interrupt();
+}
+
+bool Plic::register_handler(uint32_t source, PlicHandler handler, void* context, uint32_t priority) {
+    if (!valid_source(source) || !handler || priority == 0 || priority > MAX_PRIORITY) {
+        return false;
+    }
+
+    {
+        InterruptGuard guard;
+        handlers[source].handler = handler;
+        handlers[source].context = context;
+    }
+    set_priority(source, priority);
+    enable_source(source);
+    return true;
+}
+
+void Plic::unregister_handler(uint32_t source) {
+    if (!valid_source(source)) return;
+
+    disable_source(source);
+    InterruptGuard guard;
+    handlers[source].handler = nullptr;
+    handlers[source].context = nullptr;
+}
+
+void Plic::set_priority(uint32_t source, uint32_t priority) {
+    if (!valid_source(source) || priority > MAX_PRIORITY) return;
+    plic_reg(PLIC_PRIORITY(source)) = priority;
+}
+
+uint32_t Plic::get_priority(uint32_t source) {
+    return valid_source(source) ? plic_reg(PLIC_PRIORITY(source)) : 0;
+}
+
+void Plic::set_threshold(uint32_t threshold) {
+    if (threshold > MAX_PRIORITY) return;
+    plic_reg(PLIC_THRESHOLD_M_HART0) = threshold;
+}
+
+uint32_t Plic::get_threshold() {
+    return plic_reg(PLIC_THRESHOLD_M_HART0);
+}
+
+void Plic::enable_source(uint32_t source) {
+    if (!valid_source(source)) return;
+    InterruptGuard guard;
+    plic_reg(PLIC_ENABLE_M_HART0 + 4 * (source / 32)) |= 1u << (source % 32);
+}
+
+void Plic::disable_source(uint32_t source) {
+    if (!valid_source(source)) return;
+    InterruptGuard guard;
+    plic_reg(PLIC_ENABLE_M_HART0 + 4 * (source / 32)) &= ~(1u << (source % 32));
+}
+
+void Plic::dispatch() {
+    InterruptStats& stats = InterruptController::stats;
+    uint32_t entered = csr<CSR_MCYCLE>::read();
+    uint32_t claims = 0;
+
+    uint32_t source;
+    while ((source = plic_reg(PLIC_CLAIM_M_HART0)) != 0) {
+        claims++;
+        uint32_t started = csr<CSR_MCYCLE>::read();
+
+        if (valid_source(source) && handlers[source].handler) {
+            handlers[source].handler(source, handlers[source].context);
+        } else {
+            InterruptController::post_event(CAUSE_MACHINE_EXTERNAL_INT, source);
+        }
+
+        uint32_t finished = csr<CSR_MCYCLE>::read();
+        if (valid_source(source)) {
+            ExternalSourceStats& per_source = stats.external_sources[source];
+            uint32_t latency = started - entered;
+            uint32_t service = finished - started;
+            per_source.count++;
+            per_source.latency_total += latency;
+            if (latency > per_source.latency_max) per_source.latency_max = latency;
+            if (service > per_source.service_max) per_source.service_max = service;
+        }
+
+        // Complete: the PLIC may now raise this source again
+        plic_reg(PLIC_CLAIM_M_HART0) = source;
+    }
+
+    if (!claims) {
+        stats.unclaimed_external_count++;
+    } else if (claims > stats.max_claims_per_trap) {
+        stats.max_claims_per_trap = claims;
+    }
+}
@@ -0,0 +1,217 @@
+#include "uart_driver.h"
+#include "interrupt.h"
+#include "plic.h"
+#include "scheduler.h"
+
+// 16550 registers (QEMU virt UART0)
+#define UART_BASE           0x10000000
+#define UART_RBR            0x00    // Receive buffer (read)
+#define UART_THR            0x00    // Transmit holding (write)
+#define UART_IER            0x01    // Interrupt enable
+#define UART_IIR            0x02    // Interrupt identification (read)
+#define UART_FCR            0x02    // FIFO control (write)
+#define UART_LSR            0x05    // Line status
+
+#define IER_RX_AVAILABLE    (1 << 0)
+#define IER_THR_EMPTY       (1 << 1)
+
+#define IIR_NO_INTERRUPT    0x01
+#define IIR_ID_MASK         0x0E
+#define IIR_THR_EMPTY       0x02
+#define IIR_RX_AVAILABLE    0x04
+#define IIR_RX_TIMEOUT      0x0C
+
+#define FCR_ENABLE_CLEAR    0x07    // Enable FIFOs and clear both
+
+#define LSR_DATA_READY      (1 << 0)
+#define LSR_THR_EMPTY       (1 << 5)
+#define LSR_TX_IDLE         (1 << 6)
+
+#define UART_FIFO_DEPTH     16
+#define MAX_IRQ_PASSES      4
+
+static inline volatile uint8_t& uart_reg(uint32_t offset) {
+    return *(volatile uint8_t*)(UART_BASE + offset);
+}
+
+// Static member definitions
+SpscRing<uint8_t, UartDriver::TX_BUFFER_SIZE> UartDriver::tx_ring;
+SpscRing<uint8_t, UartDriver::RX_BUFFER_SIZE> UartDriver::rx_ring;
+UartStats UartDriver::stats = {0, 0, 0, 0, 0, 0};
+bool UartDriver::enabled = false;
+
+// Wake tasks blocked on TX ring space or on received data
+static TaskEvent tx_space;
+static TaskEvent rx_ready;
+
+void UartDriver::init() {
+    if (enabled) return;
+
+    uart_reg(UART_FCR) = FCR_ENABLE_CLEAR;
+    uart_reg(UART_IER) = IER_RX_AVAILABLE;
+
+    Plic::register_handler(PLIC_SOURCE, [](uint32_t, void*) { handle_interrupt(); }, nullptr);
+
+    enabled = true;
+}
+
+size_t UartDriver::write(const char* buf, size_t len) {
+    uint32_t queued = tx_ring.push_batch(reinterpret_cast<const uint8_t*>(buf), len);
+    if (queued) {
+        start_tx();
+    }
+    return queued;
+}
+
+void UartDriver::write_all(const char* buf, size_t len) {
+    if (!enabled) {
+        write_polled(buf, len);
+        return;
+    }
+
+    // With global interrupts off nothing would drain the ring until it
+    // filled up, so send what is queued and then these bytes directly
+    if ((csr<CSR_MSTATUS>::read() & MSTATUS_MIE) == 0) {
+        flush();
+        write_polled(buf, len);
+        return;
+    }
+
+    while (len) {
+        size_t queued = write(buf, len);
+        buf += queued;
+        len -= queued;
+        if (len) {
+            stats.tx_stalls++;
+            wait_for_tx();
+        }
+    }
+}
+
+size_t UartDriver::read(char* buf, size_t max_len) {
+    return rx_ring.pop_batch(reinterpret_cast<uint8_t*>(buf), max_len);
+}
+
+size_t UartDriver::read_blocking(char* buf, size_t max_len) {
+    if (!max_len) return 0;
+
+    for (;;) {
+        size_t count = read(buf, max_len);
+        if (count) return count;
+
+        // Same masking as wait_for_tx(): data arriving between the check
+        // and the sleep leaves the interrupt pending instead of lost
+        InterruptGuard guard;
+        if (rx_ring.empty()) {
+            if (Scheduler::is_running()) {
+                rx_ready.wait();
+            } else {
+                asm volatile ("wfi");
+            }
+        }
+    }
+}
+
+void UartDriver::flush() {
+    while (!tx_ring.empty()) {
+        wait_for_tx();
+    }
+    while ((uart_reg(UART_LSR) & LSR_TX_IDLE) == 0) {}
+}
+
+void UartDriver::write_polled(const char* buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        while ((uart_reg(UART_LSR) & LSR_THR_EMPTY) == 0) {}
+        uart_reg(UART_THR) = buf[i];
+    }
+}
+
+void UartDriver::handle_interrupt() {
+    // Service every pending cause; the PLIC re-raises anything left over
+    for (uint32_t pass = 0; pass < MAX_IRQ_PASSES; pass++) {
+        uint8_t iir = uart_reg(UART_IIR);
+        if (iir & IIR_NO_INTERRUPT) break;
+
+        switch (iir & IIR_ID_MASK) {
+            case IIR_RX_AVAILABLE:
+            case IIR_RX_TIMEOUT:
+                stats.rx_interrupts++;
+                service_rx();
+                break;
+            case IIR_THR_EMPTY:
+                stats.tx_interrupts++;
+                service_tx();
+                break;
+            default: {
+                // Line status: reading LSR clears it
+                uint8_t line_status = uart_reg(UART_LSR);
+                (void)line_status;
+                break;
+            }
+        }
+    }
+}
+
+// Enable the THR-empty interrupt; it fires at once if the FIFO is empty.
+// IER is written whole rather than read-modify-write so a concurrent
+// service_tx() in the handler cannot be undone.
+void UartDriver::start_tx() {
+    uart_reg(UART_IER) = IER_RX_AVAILABLE | IER_THR_EMPTY;
+}
+
+// Refill the transmit FIFO from the TX ring, or stop the THR-empty
+// interrupt once the ring is empty
+void UartDriver::service_tx() {
+    if ((uart_reg(UART_LSR) & LSR_THR_EMPTY) == 0) return;
+
+    uint8_t chunk[UART_FIFO_DEPTH];
+    uint32_t count = tx_ring.pop_batch(chunk, UART_FIFO_DEPTH);
+    tx_space.signal();
+    if (!count) {
+        uart_reg(UART_IER) = IER_RX_AVAILABLE;
+        return;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        uart_reg(UART_THR) = chunk[i];
+    }
+    stats.tx_bytes += count;
+}
+
+void UartDriver::service_rx() {
+    bool received = false;
+    while (uart_reg(UART_LSR) & LSR_DATA_READY) {
+        uint8_t byte = uart_reg(UART_RBR);
+        if (rx_ring.try_push(byte)) {
+            stats.rx_bytes++;
+            received = true;
+        } else {
+            stats.rx_overruns++;
+        }
+    }
+    if (received) {
+        rx_ready.signal();
+    }
+}
+
+// Wait until the TX interrupt has made progress. Interrupts are masked
+// around the check so a drain that completes just before the wait cannot
+// be missed (wfi still wakes on a pending, enabled interrupt). Under the
+// scheduler the calling task blocks instead, so other tasks keep running
+// while the UART drains. With global interrupts off the handler cannot
+// run, so refill the FIFO by polling.
+void UartDriver::wait_for_tx() {
+    if ((csr<CSR_MSTATUS>::read() & MSTATUS_MIE) == 0) {
+        service_tx();
+        return;
+    }
+
+    InterruptController::disable_global_interrupts();
+    if (!tx_ring.empty()) {
+        if (Scheduler::is_running()) {
+            tx_space.wait();
+        } else {
+            asm volatile ("wfi");
+        }
+    }
+    InterruptController::enable_global_interrupts();
+}
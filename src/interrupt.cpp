@@ -1,95 +1,23 @@
 #include "interrupt.h"
+#include "clint_timer.h"
+#include "plic.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "placement.h"
 
 // Static member definitions
-InterruptStats InterruptController::stats = {0, 0, 0, 0, 0, 0, 0};
+InterruptStats InterruptController::stats = {};
 bool InterruptController::initialized = false;
-
-// CSR access inline assembly functions
-uint32_t InterruptController::read_csr(uint32_t csr) {
-    uint32_t value;
-    switch (csr) {
-        case CSR_MSTATUS:
-            asm volatile ("csrr %0, mstatus" : "=r" (value));
-            break;
-        case CSR_MIE:
-            asm volatile ("csrr %0, mie" : "=r" (value));
-            break;
-        case CSR_MIP:
-            asm volatile ("csrr %0, mip" : "=r" (value));
-            break;
-        case CSR_MCAUSE:
-            asm volatile ("csrr %0, mcause" : "=r" (value));
-            break;
-        case CSR_MEPC:
-            asm volatile ("csrr %0, mepc" : "=r" (value));
-            break;
-        case CSR_MTVAL:
-            asm volatile ("csrr %0, mtval" : "=r" (value));
-            break;
-        default:
-            value = 0;
-            break;
-    }
-    return value;
-}
-
-void InterruptController::write_csr(uint32_t csr, uint32_t value) {
-    switch (csr) {
-        case CSR_MSTATUS:
-            asm volatile ("csrw mstatus, %0" : : "r" (value));
-            break;
-        case CSR_MIE:
-            asm volatile ("csrw mie, %0" : : "r" (value));
-            break;
-        case CSR_MIP:
-            asm volatile ("csrw mip, %0" : : "r" (value));
-            break;
-        case CSR_MEPC:
-            asm volatile ("csrw mepc, %0" : : "r" (value));
-            break;
-        default:
-            break;
-    }
-}
-
-void InterruptController::set_csr_bits(uint32_t csr, uint32_t bits) {
-    switch (csr) {
-        case CSR_MSTATUS:
-            asm volatile ("csrs mstatus, %0" : : "r" (bits));
-            break;
-        case CSR_MIE:
-            asm volatile ("csrs mie, %0" : : "r" (bits));
-            break;
-        case CSR_MIP:
-            asm volatile ("csrs mip, %0" : : "r" (bits));
-            break;
-        default:
-            break;
-    }
-}
-
-void InterruptController::clear_csr_bits(uint32_t csr, uint32_t bits) {
-    switch (csr) {
-        case CSR_MSTATUS:
-            asm volatile ("csrc mstatus, %0" : : "r" (bits));
-            break;
-        case CSR_MIE:
-            asm volatile ("csrc mie, %0" : : "r" (bits));
-            break;
-        case CSR_MIP:
-            asm volatile ("csrc mip, %0" : : "r" (bits));
-            break;
-        default:
-            break;
-    }
-}
+InterruptEventQueue InterruptController::event_queue;
+// Stamped by every trap entry (start.S)
+FAST_RAM volatile TrapTiming trap_timing = {0, 0};
 
 void InterruptController::init() {
     if (initialized) return;
     
     // Clear all interrupt enables and pending bits
-    write_csr(CSR_MIE, 0);
-    write_csr(CSR_MIP, 0);
+    write_csr<CSR_MIE>(0);
+    write_csr<CSR_MIP>(0);
     
     // Reset statistics
     reset_stats();
@@ -97,44 +25,46 @@ void InterruptController::init() {
     initialized = true;
 }
 
-void InterruptController::enable_global_interrupts() {
-    set_csr_bits(CSR_MSTATUS, MSTATUS_MIE);
-}
-
-void InterruptController::disable_global_interrupts() {
-    clear_csr_bits(CSR_MSTATUS, MSTATUS_MIE);
-}
-
-void InterruptController::enable_machine_timer_interrupt() {
-    set_csr_bits(CSR_MIE, MIE_MTIE);
-}
-
-void InterruptController::disable_machine_timer_interrupt() {
-    clear_csr_bits(CSR_MIE, MIE_MTIE);
-}
-
-void InterruptController::enable_machine_software_interrupt() {
-    set_csr_bits(CSR_MIE, MIE_MSIE);
-}
-
-void InterruptController::disable_machine_software_interrupt() {
-    clear_csr_bits(CSR_MIE, MIE_MSIE);
-}
-
-void InterruptController::enable_machine_external_interrupt() {
-    set_csr_bits(CSR_MIE, MIE_MEIE);
-}
-
-void InterruptController::disable_machine_external_interrupt() {
-    clear_csr_bits(CSR_MIE, MIE_MEIE);
-}
-
 void InterruptController::trigger_software_interrupt() {
-    set_csr_bits(CSR_MIP, MIP_MSIP);
+    *(volatile uint32_t*)CLINT_MSIP_HART0 = 1;
 }
 
 void InterruptController::clear_software_interrupt() {
-    clear_csr_bits(CSR_MIP, MIP_MSIP);
+    *(volatile uint32_t*)CLINT_MSIP_HART0 = 0;
+}
+
+void InterruptController::measure_trap_latency(uint32_t rounds, TrapLatency& result) {
+    uint32_t saved_mie = read_csr<CSR_MIE>();
+    enable_machine_software_interrupt();
+    
+    uint32_t entry_total = 0;
+    uint32_t exit_total = 0;
+    result.frame_bytes = trap_frame_size;
+    result.entry_min = 0xFFFFFFFF;
+    result.exit_min = 0xFFFFFFFF;
+    
+    for (uint32_t i = 0; i < rounds; i++) {
+        volatile uint32_t* taken = &stats.machine_software_count;
+        uint32_t before = *taken;
+        uint32_t raised;
+        uint32_t resumed;
+        raised = csr<CSR_MCYCLE>::read();
+        trigger_software_interrupt();
+        // The trap may be taken a few instructions after the CLINT write
+        while (*taken == before) {}
+        resumed = csr<CSR_MCYCLE>::read();
+        
+        uint32_t entry = trap_timing.handler_enter - raised;
+        uint32_t exit = resumed - trap_timing.handler_exit;
+        entry_total += entry;
+        exit_total += exit;
+        if (entry < result.entry_min) result.entry_min = entry;
+        if (exit < result.exit_min) result.exit_min = exit;
+    }
+    
+    result.entry_avg = rounds ? entry_total / rounds : 0;
+    result.exit_avg = rounds ? exit_total / rounds : 0;
+    write_csr<CSR_MIE>(saved_mie);
 }
 
 void InterruptController::reset_stats() {
@@ -145,6 +75,26 @@ void InterruptController::reset_stats() {
     stats.supervisor_timer_count = 0;
     stats.supervisor_external_count = 0;
     stats.unhandled_exception_count = 0;
+    stats.dropped_event_count = 0;
+    stats.unclaimed_external_count = 0;
+    stats.max_claims_per_trap = 0;
+    for (uint32_t i = 0; i < PLIC_MAX_SOURCES; i++) {
+        ExternalSourceStats& source = stats.external_sources[i];
+        source.count = 0;
+        source.latency_total = 0;
+        source.latency_max = 0;
+        source.service_max = 0;
+    }
+}
+
+void InterruptController::post_event(uint32_t cause, uint32_t source) {
+    InterruptEvent event;
+    event.cause = cause;
+    event.source = source;
+    event.timestamp = csr<CSR_MCYCLE>::read();
+    if (!event_queue.try_push(event)) {
+        stats.dropped_event_count++;
+    }
 }
 
 // C-style interrupt handler implementations
@@ -154,9 +104,9 @@ void unhandled_exception_handler() {
     InterruptController::stats.unhandled_exception_count++;
     
     // Read cause and handle accordingly
-    uint32_t cause = InterruptController::read_csr(CSR_MCAUSE);
-    uint32_t epc = InterruptController::read_csr(CSR_MEPC);
-    uint32_t tval = InterruptController::read_csr(CSR_MTVAL);
+    uint32_t cause = InterruptController::read_csr<CSR_MCAUSE>();
+    uint32_t epc = InterruptController::read_csr<CSR_MEPC>();
+    uint32_t tval = InterruptController::read_csr<CSR_MTVAL>();
     
     // In a real system, you might want to log this information
     // For now, we just increment the counter
@@ -175,35 +125,48 @@ void unhandled_exception_handler() {
 }
 
 void machine_software_interrupt_handler() {
-    InterruptController::stats.machine_software_count++;
-    
-    // Clear the software interrupt
-    InterruptController::clear_software_interrupt();
+    {
+        PROFILE_SCOPE("isr_machine_software");
+        InterruptController::stats.machine_software_count++;
+
+        // Clear the software interrupt
+        InterruptController::clear_software_interrupt();
+    }
+
+    // Deferred task switch, if one was requested (may not return until
+    // the interrupted task is scheduled again, so it stays out of the probe)
+    Scheduler::handle_switch_request();
 }
 
 void machine_timer_interrupt_handler() {
+    PROFILE_SCOPE("isr_machine_timer");
     InterruptController::stats.machine_timer_count++;
     
-    // Timer interrupt handling would go here
-    // In QEMU virt machine, you might need to clear the timer interrupt
-    // by writing to memory-mapped timer registers
+    // Runs due software timers and reprograms mtimecmp, which also
+    // clears the pending interrupt
+    ClintTimer::handle_interrupt();
 }
 
 void machine_external_interrupt_handler() {
+    PROFILE_SCOPE("isr_machine_external");
     InterruptController::stats.machine_external_count++;
     
-    // External interrupt handling (UART, GPIO, etc.) would go here
+    // Service every pending PLIC source in this trap
+    Plic::dispatch();
 }
 
 void supervisor_software_interrupt_handler() {
+    PROFILE_SCOPE("isr_supervisor_software");
     InterruptController::stats.supervisor_software_count++;
 }
 
 void supervisor_timer_interrupt_handler() {
+    PROFILE_SCOPE("isr_supervisor_timer");
     InterruptController::stats.supervisor_timer_count++;
 }
 
 void supervisor_external_interrupt_handler() {
+    PROFILE_SCOPE("isr_supervisor_external");
     InterruptController::stats.supervisor_external_count++;
 }
 
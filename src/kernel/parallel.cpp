@@ -0,0 +1,100 @@
+#include "parallel.h"
+#include "smp.h"
+#include "scheduler.h"
+#include "spinlock.h"
+
+static uint32_t concurrency_limit = 0;
+
+void TaskGroup::run(void (*function)(void* arg), void* arg) {
+    uint32_t index = __atomic_fetch_add(&used, 1u, __ATOMIC_RELAXED);
+    if (index < MAX_JOBS) {
+        Job& job = jobs[index];
+        job.group = this;
+        job.function = function;
+        job.arg = arg;
+        __atomic_fetch_add(&pending, 1u, __ATOMIC_RELAXED);
+        if (Smp::submit(SmpJob{execute, &job})) return;
+        __atomic_fetch_sub(&pending, 1u, __ATOMIC_RELAXED);
+    }
+    function(arg);
+}
+
+void TaskGroup::wait() {
+    while (__atomic_load_n(&pending, __ATOMIC_ACQUIRE)) {
+        if (!Smp::run_one()) cpu_relax();
+    }
+    used = 0;
+}
+
+void TaskGroup::execute(void* record) {
+    Job* job = static_cast<Job*>(record);
+    TaskGroup* group = job->group;
+    job->function(job->arg);
+    // Release: the job's writes are visible to whoever sees pending drop
+    __atomic_fetch_sub(&group->pending, 1u, __ATOMIC_RELEASE);
+}
+
+// Shared by every hart working on one parallel_for
+struct ParallelLoop {
+    RangeFunction function;
+    void* context;
+    size_t begin;
+    size_t end;
+    size_t grain;
+    size_t next;        // Start of the next unclaimed chunk
+};
+
+static void run_chunks(void* arg) {
+    ParallelLoop* loop = static_cast<ParallelLoop*>(arg);
+    for (;;) {
+        size_t first = __atomic_fetch_add(&loop->next, loop->grain, __ATOMIC_RELAXED);
+        if (first >= loop->end) return;
+        size_t last = loop->end - first > loop->grain ? first + loop->grain : loop->end;
+        loop->function(first, last, loop->context);
+    }
+}
+
+void parallel_for(size_t begin, size_t end, size_t grain, RangeFunction function, void* context) {
+    if (begin >= end) return;
+    if (!grain) grain = 1;
+
+    uint32_t harts = parallel_concurrency();
+    if (end - begin <= grain) {
+        function(begin, end, context);
+        return;
+    }
+
+    if (harts == 1) {
+        bool scheduled = Scheduler::is_running() && Smp::hart_id() == 0;
+        for (size_t first = begin; first < end; first += grain) {
+            size_t last = end - first > grain ? first + grain : end;
+            function(first, last, context);
+            if (scheduled) Scheduler::yield();
+        }
+        return;
+    }
+
+    // One helper per extra hart (no more than there are chunks); the
+    // caller claims chunks too, so the loop completes even if no helper
+    // is ever stolen
+    ParallelLoop loop = {function, context, begin, end, grain, begin};
+    size_t chunks = (end - begin + grain - 1) / grain;
+    uint32_t helpers = harts - 1;
+    if (helpers > chunks - 1) helpers = chunks - 1;
+
+    TaskGroup group;
+    for (uint32_t i = 0; i < helpers; i++) {
+        group.run(run_chunks, &loop);
+    }
+    run_chunks(&loop);
+    group.wait();
+}
+
+uint32_t parallel_concurrency() {
+    uint32_t harts = Smp::hart_count();
+    return concurrency_limit && concurrency_limit < harts ? concurrency_limit : harts;
+}
+
+void set_parallel_concurrency(uint32_t harts) {
+    concurrency_limit = harts;
+}
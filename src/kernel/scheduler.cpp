@@ -0,0 +1,413 @@
+#include "scheduler.h"
+#include "interrupt.h"
+#include "placement.h"
+
+// Task stack pool and boot stack (linker.ld)
+extern "C" {
+    extern uint8_t __task_stacks_start;
+    extern uint8_t __task_stacks_end;
+    extern uint32_t __stack_bottom[];
+    extern uint32_t __stack_top[];
+
+    // start.S
+    void context_switch(uint32_t** save_sp, uint32_t* load_sp);
+    void task_trampoline();
+}
+
+// Slots of the start.S context frame that a new task starts from
+#define CONTEXT_RA_SLOT     0
+#define CONTEXT_S0_SLOT     1
+
+static inline uint64_t cycles_now() {
+    return csr_read64<CSR_MCYCLE, CSR_MCYCLEH>();
+}
+
+// Static member definitions; what every switch touches is in DTCM_FAST
+FAST_RAM Task Scheduler::tasks[MAX_TASKS] = {};
+uint32_t Scheduler::task_total = 0;
+FAST_RAM Task* Scheduler::current = nullptr;
+FAST_RAM Task* Scheduler::ready_heads[MAX_PRIORITIES];
+FAST_RAM Task* Scheduler::ready_tails[MAX_PRIORITIES];
+FAST_RAM uint32_t Scheduler::ready_bitmap = 0;
+uint8_t* Scheduler::stack_pool_next = nullptr;
+FAST_RAM SchedulerStats Scheduler::stats = {};
+FAST_RAM bool Scheduler::preemptive = false;
+FAST_RAM bool Scheduler::switch_requested = false;
+FAST_RAM bool Scheduler::slice_expired = false;
+uint64_t Scheduler::slice_ticks = 0;
+TimerId Scheduler::slice_timer = 0;
+
+void Scheduler::init() {
+    if (current) return;
+
+    stack_pool_next = &__task_stacks_start;
+    stats.start_cycles = cycles_now();
+
+    Task& main_task = tasks[0];
+    main_task = Task();
+    main_task.name = "main";
+    main_task.state = TaskState::Running;
+    main_task.priority = DEFAULT_PRIORITY;
+    main_task.stack_base = __stack_bottom;
+    main_task.stack_size = (__stack_top - __stack_bottom) * sizeof(uint32_t);
+    main_task.switches = 1;
+    main_task.run_started = stats.start_cycles;
+    task_total = 1;
+
+    // Paint the unused part of the boot stack, leaving a margin below sp
+    // for this function's own frame
+    uint32_t* sp;
+    asm volatile ("mv %0, sp" : "=r" (sp));
+    for (uint32_t* word = main_task.stack_base; word < sp - 16; word++) {
+        *word = STACK_PAINT;
+    }
+    current = &main_task;
+}
+
+Task* Scheduler::create(const char* name, TaskEntry entry, void* arg, uint32_t stack_size,
+                        uint8_t priority) {
+    stack_size = (stack_size + 15) & ~15u;
+    if (!current || !entry || priority >= MAX_PRIORITIES ||
+        stack_size < CONTEXT_FRAME_WORDS * 4 * 2) {
+        return nullptr;
+    }
+
+    InterruptGuard guard;
+    if (task_total == MAX_TASKS || stack_size > (uint32_t)(&__task_stacks_end - stack_pool_next)) {
+        return nullptr;
+    }
+
+    Task& task = tasks[task_total++];
+    task = Task();
+    task.name = name;
+    task.entry = entry;
+    task.arg = arg;
+    task.priority = priority;
+    task.stack_base = (uint32_t*)stack_pool_next;
+    task.stack_size = stack_size;
+    stack_pool_next += stack_size;
+
+    // Paint the stack for stack_usage(), then build the frame that
+    // context_switch() pops on the first switch: ra enters the trampoline,
+    // which passes s0 (the TCB) to task_main()
+    uint32_t words = stack_size / 4;
+    for (uint32_t i = 0; i < words; i++) {
+        task.stack_base[i] = STACK_PAINT;
+    }
+    uint32_t* frame = task.stack_base + words - CONTEXT_FRAME_WORDS;
+    for (uint32_t i = 0; i < CONTEXT_FRAME_WORDS; i++) {
+        frame[i] = 0;
+    }
+    frame[CONTEXT_RA_SLOT] = (uint32_t)&task_trampoline;
+    frame[CONTEXT_S0_SLOT] = (uint32_t)&task;
+    task.sp = frame;
+
+    make_ready(&task, false);
+    return &task;
+}
+
+void Scheduler::set_priority(Task* task, uint8_t priority) {
+    if (!task || priority >= MAX_PRIORITIES) return;
+
+    InterruptGuard guard;
+    if (task->state != TaskState::Ready) {
+        task->priority = priority;
+    } else {
+        // Requeue at the new level
+        uint8_t level = task->priority;
+        Task* previous = nullptr;
+        for (Task* it = ready_heads[level]; it && it != task; it = it->next) {
+            previous = it;
+        }
+        if (previous) {
+            previous->next = task->next;
+        } else {
+            ready_heads[level] = task->next;
+        }
+        if (ready_tails[level] == task) ready_tails[level] = previous;
+        if (!ready_heads[level]) ready_bitmap &= ~(1u << level);
+
+        task->priority = priority;
+        make_ready(task, task->woken);
+    }
+
+    // A lowered running task may now be outranked
+    if (preemptive && task == current) {
+        int32_t highest = highest_ready();
+        if (highest > (int32_t)current->priority) request_switch();
+    }
+}
+
+void Scheduler::enable_preemption(uint64_t ticks) {
+    InterruptGuard guard;
+    if (slice_timer) ClintTimer::cancel(slice_timer);
+    slice_ticks = ticks;
+    preemptive = true;
+    slice_timer = ClintTimer::schedule_after(slice_ticks, on_slice, nullptr);
+    InterruptController::enable_machine_software_interrupt();
+}
+
+void Scheduler::disable_preemption() {
+    InterruptGuard guard;
+    preemptive = false;
+    if (slice_timer) {
+        ClintTimer::cancel(slice_timer);
+        slice_timer = 0;
+    }
+}
+
+HOT_CODE void Scheduler::yield() {
+    InterruptGuard guard;
+    if (!current || highest_ready() < (int32_t)current->priority) return;
+
+    make_ready(current, false);
+    switch_to(take_ready());
+}
+
+void Scheduler::sleep(uint64_t ticks) {
+    uint64_t deadline = ClintTimer::now() + ticks;
+    InterruptGuard guard;
+    Task* task = current;
+    task->state = TaskState::Sleeping;
+    TimerId timer = ClintTimer::schedule_at(deadline, [](void* context) {
+        Scheduler::wake((Task*)context);
+    }, task);
+
+    if (timer) {
+        block();
+        return;
+    }
+
+    // No timer slot free: fall back to polling the deadline between yields
+    task->state = TaskState::Running;
+    while (ClintTimer::now() < deadline) {
+        if (highest_ready() >= (int32_t)task->priority) {
+            make_ready(task, false);
+            switch_to(take_ready());
+        } else {
+            InterruptController::enable_global_interrupts();
+            InterruptController::disable_global_interrupts();
+        }
+    }
+}
+
+void Scheduler::sleep_ms(uint32_t ms) {
+    sleep(ClintTimer::ms_to_ticks(ms));
+}
+
+void Scheduler::join(Task* task) {
+    if (!task || task == current) return;
+    while (task->state != TaskState::Finished) {
+        task->exited.wait();
+    }
+}
+
+void Scheduler::exit() {
+    InterruptGuard guard;
+    current->state = TaskState::Finished;
+    current->exited.signal();
+    block();
+
+    // A finished task is never made ready again
+    for (;;) {}
+}
+
+HOT_CODE void Scheduler::wake(Task* task) {
+    InterruptGuard guard;
+    if (task->state == TaskState::Sleeping || task->state == TaskState::Waiting) {
+        make_ready(task, true);
+    }
+}
+
+// Runs in the machine software interrupt, after every other pending
+// handler. The interrupted task is suspended inside this call (on top of
+// its trap frame) and resumes here when it is next switched in.
+HOT_CODE void Scheduler::handle_switch_request() {
+    if (!switch_requested) return;
+    switch_requested = false;
+
+    // A task that is blocking (or already requeued) opened interrupts from
+    // inside the scheduler; it picks the next task itself
+    if (!current || current->state != TaskState::Running) return;
+
+    int32_t highest = highest_ready();
+    bool rotate = slice_expired && highest == (int32_t)current->priority;
+    slice_expired = false;
+    if (highest < 0 || (highest <= (int32_t)current->priority && !rotate)) return;
+
+    stats.preemptions++;
+    current->preemptions++;
+    make_ready(current, false);
+    switch_to(take_ready());
+}
+
+void Scheduler::update_cpu_usage() {
+    InterruptGuard guard;
+    uint64_t now = cycles_now();
+    current->run_cycles += now - current->run_started;
+    current->run_started = now;
+}
+
+uint32_t Scheduler::stack_usage(const Task* task) {
+    uint32_t words = task->stack_size / 4;
+    uint32_t untouched = 0;
+    while (untouched < words && task->stack_base[untouched] == STACK_PAINT) {
+        untouched++;
+    }
+    return (words - untouched) * 4;
+}
+
+void Scheduler::task_main(Task* task) {
+    // Every switch happens with interrupts masked; a new task starts with
+    // them enabled, like main after boot
+    InterruptController::enable_global_interrupts();
+    task->entry(task->arg);
+    exit();
+}
+
+HOT_CODE void Scheduler::make_ready(Task* task, bool woken) {
+    uint8_t level = task->priority;
+    task->state = TaskState::Ready;
+    task->next = nullptr;
+    if (woken) {
+        task->woken = true;
+        task->wakeups++;
+        task->ready_stamp = csr<CSR_MCYCLE>::read();
+    }
+
+    if (ready_tails[level]) {
+        ready_tails[level]->next = task;
+    } else {
+        ready_heads[level] = task;
+    }
+    ready_tails[level] = task;
+    ready_bitmap |= 1u << level;
+
+    if (preemptive && current && task != current && level > current->priority) {
+        request_switch();
+    }
+}
+
+HOT_CODE Task* Scheduler::take_ready() {
+    int32_t level = highest_ready();
+    if (level < 0) return nullptr;
+
+    Task* task = ready_heads[level];
+    ready_heads[level] = task->next;
+    if (!ready_heads[level]) {
+        ready_tails[level] = nullptr;
+        ready_bitmap &= ~(1u << level);
+    }
+    task->next = nullptr;
+    return task;
+}
+
+// Highest priority with a ready task, -1 if none
+HOT_CODE int32_t Scheduler::highest_ready() {
+    return ready_bitmap ? 31 - __builtin_clz(ready_bitmap) : -1;
+}
+
+// Raise MSIP; the switch happens once interrupts are open and no other
+// handler is running
+HOT_CODE void Scheduler::request_switch() {
+    if (!switch_requested) {
+        switch_requested = true;
+        stats.switch_requests++;
+        InterruptController::trigger_software_interrupt();
+    }
+}
+
+// Time slice (machine timer interrupt): rotate if the running priority
+// has other ready tasks, then re-arm
+HOT_CODE void Scheduler::on_slice(void*) {
+    slice_timer = 0;
+    if (!preemptive) return;
+
+    if (current && current->state == TaskState::Running &&
+        highest_ready() == (int32_t)current->priority) {
+        slice_expired = true;
+        stats.slice_expiries++;
+        request_switch();
+    }
+    slice_timer = ClintTimer::schedule_after(slice_ticks, on_slice, nullptr);
+}
+
+// Give up the CPU until something makes the current task ready again.
+// Called with interrupts masked. With nothing ready, wait in wfi and open
+// interrupts briefly after each wakeup so the handler can run; the ready
+// check stays under the mask, so a wakeup between check and wfi is kept
+// pending rather than lost. Idle time is not charged to the task.
+HOT_CODE void Scheduler::block() {
+    if (!ready_bitmap) {
+        uint64_t idle_start = cycles_now();
+        current->run_cycles += idle_start - current->run_started;
+        while (!ready_bitmap) {
+            asm volatile ("wfi");
+            InterruptController::enable_global_interrupts();
+            InterruptController::disable_global_interrupts();
+        }
+        uint64_t idle_end = cycles_now();
+        stats.idle_cycles += idle_end - idle_start;
+        current->run_started = idle_end;
+    }
+    switch_to(take_ready());
+}
+
+HOT_CODE void Scheduler::switch_to(Task* next) {
+    Task* previous = current;
+    next->state = TaskState::Running;
+
+    if (next->woken) {
+        uint32_t latency = csr<CSR_MCYCLE>::read() - next->ready_stamp;
+        next->woken = false;
+        next->latency_total += latency;
+        if (latency > next->latency_max) next->latency_max = latency;
+        if (latency > stats.latency_max) stats.latency_max = latency;
+    }
+    if (next == previous) return;
+
+    uint64_t now = cycles_now();
+    previous->run_cycles += now - previous->run_started;
+    next->run_started = now;
+    next->switches++;
+    stats.context_switches++;
+    current = next;
+    context_switch(&previous->sp, next->sp);
+}
+
+HOT_CODE void TaskEvent::wait() {
+    InterruptGuard guard;
+    if (pending) {
+        pending = false;
+        return;
+    }
+
+    Task* task = Scheduler::current;
+    task->state = TaskState::Waiting;
+    task->next = nullptr;
+    if (tail) {
+        tail->next = task;
+    } else {
+        head = task;
+    }
+    tail = task;
+    Scheduler::block();
+}
+
+HOT_CODE void TaskEvent::signal() {
+    InterruptGuard guard;
+    if (!head) {
+        pending = true;
+        return;
+    }
+    while (head) {
+        Task* task = head;
+        head = task->next;
+        Scheduler::make_ready(task, true);
+    }
+    tail = nullptr;
+}
+
+extern "C" void scheduler_task_main(Task* task) {
+    Scheduler::task_main(task);
+}
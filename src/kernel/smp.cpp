@@ -0,0 +1,138 @@
+#include "smp.h"
+#include "interrupt.h"
+#include "clint_timer.h"
+
+// Boot handshake words (start.S)
+extern "C" {
+    extern uint32_t smp_harts_arrived;
+    extern uint32_t smp_boot_release;
+}
+
+// Static member definitions
+Smp::Hart Smp::harts[MAX_HARTS] = {};
+uint32_t Smp::harts_online = 1;
+
+void Smp::init() {
+    if (harts[0].online) return;
+    harts[0].online = 1;
+
+    // Secondaries check in within a few instructions of reset; give any
+    // that are still on their way a moment before counting them
+    uint64_t deadline = ClintTimer::now() + ClintTimer::ms_to_ticks(1);
+    while (__atomic_load_n(&smp_harts_arrived, __ATOMIC_ACQUIRE) < MAX_HARTS - 1 &&
+           ClintTimer::now() < deadline) {
+    }
+    // QEMU numbers harts 0..N-1, so the arrivals are harts 1..arrived
+    uint32_t arrived = __atomic_load_n(&smp_harts_arrived, __ATOMIC_ACQUIRE);
+    harts_online = 1 + arrived;
+
+    __atomic_store_n(&smp_boot_release, 1u, __ATOMIC_RELEASE);
+    for (uint32_t hart = 1; hart < harts_online; hart++) {
+        send_ipi(hart);
+    }
+    for (uint32_t hart = 1; hart < harts_online; hart++) {
+        while (!__atomic_load_n(&harts[hart].online, __ATOMIC_ACQUIRE)) {
+        }
+    }
+}
+
+bool Smp::submit(const SmpJob& job) {
+    uint32_t self = hart_id();
+    {
+        // Owner operations must not interleave with a preempting task
+        InterruptGuard guard;
+        if (!harts[self].deque.push(job)) return false;
+    }
+    wake_sleepers(self);
+    return true;
+}
+
+bool Smp::run_one() {
+    uint32_t self = hart_id();
+    SmpJob job;
+    if (!find_job(self, job)) return false;
+
+    job.function(job.arg);
+    harts[self].stats.jobs_run++;
+    return true;
+}
+
+void Smp::send_ipi(uint32_t hart) {
+    *(volatile uint32_t*)CLINT_MSIP(hart) = 1;
+}
+
+void Smp::reset_stats() {
+    for (Hart& hart : harts) {
+        hart.stats = HartStats();
+    }
+}
+
+// Own deque first (newest job), then the other harts' (oldest job),
+// starting with the next hart up so thieves spread over the victims
+bool Smp::find_job(uint32_t self, SmpJob& job) {
+    {
+        InterruptGuard guard;
+        if (harts[self].deque.pop(job)) return true;
+    }
+
+    uint32_t count = __atomic_load_n(&harts_online, __ATOMIC_RELAXED);
+    HartStats& stats = harts[self].stats;
+    for (uint32_t i = 1; i < count; i++) {
+        uint32_t victim = self + i < count ? self + i : self + i - count;
+        if (harts[victim].deque.empty()) continue;
+        stats.steal_attempts++;
+        if (harts[victim].deque.steal(job)) {
+            stats.jobs_stolen++;
+            return true;
+        }
+    }
+    return false;
+}
+
+// The job was published before this fence and a sleeper sets its flag
+// before its last look at the deques, so either it sees the job or we
+// see the flag. Taking the flag means one IPI per sleep, not per job.
+void Smp::wake_sleepers(uint32_t self) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    uint32_t count = __atomic_load_n(&harts_online, __ATOMIC_RELAXED);
+    for (uint32_t hart = 0; hart < count; hart++) {
+        if (hart == self || !__atomic_load_n(&harts[hart].sleeping, __ATOMIC_RELAXED)) continue;
+        if (__atomic_exchange_n(&harts[hart].sleeping, 0u, __ATOMIC_RELAXED)) {
+            send_ipi(hart);
+            harts[self].stats.ipis_sent++;
+        }
+    }
+}
+
+void Smp::secondary_main(uint32_t hart) {
+    Hart& self = harts[hart];
+    *(volatile uint32_t*)CLINT_MSIP(hart) = 0;
+    __atomic_store_n(&self.online, 1u, __ATOMIC_RELEASE);
+
+    SmpJob job;
+    for (;;) {
+        if (find_job(hart, job)) {
+            job.function(job.arg);
+            self.stats.jobs_run++;
+            continue;
+        }
+
+        __atomic_store_n(&self.sleeping, 1u, __ATOMIC_SEQ_CST);
+        if (!find_job(hart, job)) {
+            // A pending IPI makes wfi return at once, so one sent after
+            // the check above is not lost
+            asm volatile ("wfi");
+            *(volatile uint32_t*)CLINT_MSIP(hart) = 0;
+            __atomic_store_n(&self.sleeping, 0u, __ATOMIC_RELAXED);
+            self.stats.wakeups++;
+            continue;
+        }
+        __atomic_store_n(&self.sleeping, 0u, __ATOMIC_RELAXED);
+        job.function(job.arg);
+        self.stats.jobs_run++;
+    }
+}
+
+extern "C" void smp_secondary_main(uint32_t hart) {
+    Smp::secondary_main(hart);
+}
@@ -0,0 +1,105 @@
+#include "binlog.h"
+#include "scheduler.h"
+#include "uart_driver.h"
+
+// Static member definitions
+LogHartBuffer BinLog::harts[Smp::MAX_HARTS] = {};
+uint32_t BinLog::drained = 0;
+char BinLog::line[LINE_MAX];
+
+// %s arguments are addresses in our own address space
+static const char* resolve_string(uint32_t address, void*) {
+    return (const char*)(uintptr_t)address;
+}
+
+void BinLog::init() {
+    Scheduler::create("log", drain_task, nullptr, DRAIN_STACK_SIZE, DRAIN_PRIORITY);
+}
+
+// Interrupts stay masked from the pop to the UART write, so a preempting
+// task's flush() can't emit a later record ahead of this one. That is one
+// record's formatting, bounded by LINE_MAX.
+bool BinLog::drain_one(uint32_t hart) {
+    LogRing& ring = harts[hart].ring;
+    InterruptGuard guard;
+    if (UartDriver::is_enabled() && UartDriver::tx_free() < LINE_MAX) {
+        return false;
+    }
+
+    // Frame sync, then the record; the producer publishes whole records,
+    // so once the header is there the rest is too
+    uint32_t frame[1 + LogRecord::MAX_WORDS];
+    if (!ring.try_pop(frame[1])) {
+        return false;
+    }
+    uint32_t header = frame[1];
+    uint32_t arg_count = LogRecord::arg_count_of(header);
+    ring.pop_batch(frame + 2, LogRecord::HEADER_WORDS - 1 + arg_count);
+    drained++;
+
+#if BINLOG_RAW
+    frame[0] = LogRecord::FRAME_SYNC | hart;
+    UartDriver::write_all((const char*)frame, 4 * (1 + LogRecord::HEADER_WORDS + arg_count));
+#else
+    (void)hart;
+    uint32_t site = LogRecord::site_of(header);
+    if (site == LogRecord::PROBE_SITE) {
+        // Timeline samples only mean something to the host decoder
+        return true;
+    }
+    const char* format = site < site_count() ? __start_binlog_sites[site].format
+                                             : "<bad log site>\n";
+    size_t len = LogFormatter::format(line, LINE_MAX, format, frame + 1 + LogRecord::HEADER_WORDS,
+                                      arg_count, resolve_string, nullptr);
+    UartDriver::write_all(line, len);
+#endif
+    return true;
+}
+
+uint32_t BinLog::drain(uint32_t max_records) {
+    uint32_t count = 0;
+    for (uint32_t hart = 0; hart < Smp::MAX_HARTS; hart++) {
+        while (count < max_records && drain_one(hart)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void BinLog::flush() {
+    while (pending()) {
+        if (!drain(0xFFFFFFFF)) {
+            // Stalled on TX ring space
+            UartDriver::flush();
+        }
+    }
+    UartDriver::flush();
+}
+
+uint32_t BinLog::pending() {
+    uint32_t words = 0;
+    for (const LogHartBuffer& log : harts) {
+        words += log.ring.size();
+    }
+    return words;
+}
+
+BinLogStats BinLog::get_stats() {
+    BinLogStats stats = {0, 0, drained};
+    for (const LogHartBuffer& log : harts) {
+        stats.written += log.written;
+        stats.dropped += log.dropped;
+    }
+    return stats;
+}
+
+// Lowest priority: runs whenever everything else is blocked, then sleeps
+// so an idle system isn't kept awake polling empty rings
+void BinLog::drain_task(void*) {
+    for (;;) {
+        while (drain(DRAIN_BATCH) == DRAIN_BATCH) {
+            Scheduler::yield();
+        }
+        Scheduler::sleep_ms(DRAIN_PERIOD_MS);
+    }
+}
@@ -0,0 +1,108 @@
+#include "log_format.h"
+
+// Bounded output cursor; characters past the end are dropped
+struct LogOutput {
+    char* out;
+    size_t capacity;    // Characters that fit, excluding the terminator
+    size_t length;
+
+    void put(char c) {
+        if (length < capacity) {
+            out[length++] = c;
+        }
+    }
+};
+
+static void put_digits(LogOutput& output, uint32_t value, uint32_t base, bool negative,
+                       uint32_t width, bool zero_pad) {
+    char digits[11];
+    uint32_t count = 0;
+    do {
+        uint32_t digit = value % base;
+        digits[count++] = (char)(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    } while (value);
+
+    uint32_t used = count + (negative ? 1 : 0);
+    if (negative && zero_pad) output.put('-');
+    for (; used < width; used++) {
+        output.put(zero_pad ? '0' : ' ');
+    }
+    if (negative && !zero_pad) output.put('-');
+    while (count) {
+        output.put(digits[--count]);
+    }
+}
+
+size_t LogFormatter::format(char* out, size_t out_size, const char* format,
+                            const uint32_t* args, uint32_t arg_count,
+                            LogStringResolver resolve, void* context) {
+    if (!out_size) return 0;
+
+    LogOutput output = {out, out_size - 1, 0};
+    uint32_t next_arg = 0;
+
+    while (*format) {
+        char c = *format++;
+        if (c != '%') {
+            output.put(c);
+            continue;
+        }
+
+        bool zero_pad = false;
+        uint32_t width = 0;
+        if (*format == '0') {
+            zero_pad = true;
+            format++;
+        }
+        while (*format >= '0' && *format <= '9') {
+            width = width * 10 + (uint32_t)(*format++ - '0');
+        }
+
+        char conversion = *format;
+        if (!conversion) break;
+        format++;
+        if (conversion == '%') {
+            output.put('%');
+            continue;
+        }
+        if (next_arg == arg_count) {
+            output.put('?');
+            continue;
+        }
+
+        uint32_t arg = args[next_arg++];
+        switch (conversion) {
+        case 'd': {
+            bool negative = (int32_t)arg < 0;
+            put_digits(output, negative ? 0u - arg : arg, 10, negative, width, zero_pad);
+            break;
+        }
+        case 'u':
+            put_digits(output, arg, 10, false, width, zero_pad);
+            break;
+        case 'x':
+            put_digits(output, arg, 16, false, width, zero_pad);
+            break;
+        case 'c':
+            output.put((char)arg);
+            break;
+        case 's': {
+            const char* str = resolve ? resolve(arg, context) : nullptr;
+            if (!str) str = "(null)";
+            while (*str) {
+                output.put(*str++);
+            }
+            break;
+        }
+        default:
+            // Unknown conversion: show it verbatim so the site is findable
+            output.put('%');
+            output.put(conversion);
+            break;
+        }
+    }
+
+    out[output.length] = '\0';
+    return output.length;
+}
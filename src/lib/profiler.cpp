@@ -0,0 +1,145 @@
+#include "profiler.h"
+#include "interrupt.h"
+#include "uart.h"
+
+// Static member definitions
+ProfileProbe* Profiler::probes[MAX_PROBES];
+uint32_t Profiler::probe_total = 0;
+
+uint32_t ProfileProbe::bucket_of(uint32_t cycles) {
+    if (cycles < (1u << (SUB_BUCKET_BITS + 1))) {
+        return cycles;
+    }
+    uint32_t msb = 31 - __builtin_clz(cycles);
+    uint32_t shift = msb - SUB_BUCKET_BITS;
+    uint32_t sub = (cycles >> shift) & ((1u << SUB_BUCKET_BITS) - 1);
+    return ((msb - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) | sub;
+}
+
+uint32_t ProfileProbe::bucket_upper(uint32_t bucket) {
+    if (bucket < (1u << (SUB_BUCKET_BITS + 1))) {
+        return bucket;
+    }
+    uint32_t msb = (bucket >> SUB_BUCKET_BITS) + SUB_BUCKET_BITS - 1;
+    uint32_t shift = msb - SUB_BUCKET_BITS;
+    uint32_t sub = bucket & ((1u << SUB_BUCKET_BITS) - 1);
+    uint32_t lower = (1u << msb) | (sub << shift);
+    return lower + ((1u << shift) - 1);
+}
+
+void ProfileProbe::record(uint64_t cycles, uint64_t instret, uint64_t events) {
+    if (id_ == UNREGISTERED) {
+        id_ = Profiler::register_probe(this);
+    }
+
+    // The histogram and min/max are 32-bit; totals keep the full width
+    uint32_t clamped = cycles > 0xFFFFFFFF ? 0xFFFFFFFF : (uint32_t)cycles;
+    count_++;
+    total_cycles_ += cycles;
+    total_instret_ += instret;
+    total_events_ += events;
+    if (clamped < min_cycles_) min_cycles_ = clamped;
+    if (clamped > max_cycles_) max_cycles_ = clamped;
+    buckets_[bucket_of(clamped)]++;
+}
+
+void ProfileProbe::reset() {
+    count_ = 0;
+    min_cycles_ = 0xFFFFFFFF;
+    max_cycles_ = 0;
+    total_cycles_ = 0;
+    total_instret_ = 0;
+    total_events_ = 0;
+    for (uint32_t i = 0; i < BUCKET_COUNT; i++) {
+        buckets_[i] = 0;
+    }
+}
+
+uint32_t ProfileProbe::percentile_cycles(uint32_t percent) const {
+    if (!count_) return 0;
+
+    // Rank of the sample at the percentile, rounded up (nearest-rank)
+    uint32_t rank = (uint32_t)(((uint64_t)count_ * percent + 99) / 100);
+    if (rank == 0) rank = 1;
+
+    uint32_t seen = 0;
+    for (uint32_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        seen += buckets_[bucket];
+        if (seen >= rank) {
+            uint32_t upper = bucket_upper(bucket);
+            return upper < max_cycles_ ? upper : max_cycles_;
+        }
+    }
+    return max_cycles_;
+}
+
+void Profiler::init() {
+#if PROFILE_HPM_EVENT
+    csr<CSR_MHPMEVENT3>::write(PROFILE_HPM_EVENT);
+    csr<CSR_MHPMCOUNTER3>::write(0);
+    csr<CSR_MHPMCOUNTER3H>::write(0);
+    // Bits 0/2/3: mcycle, minstret, mhpmcounter3
+    csr<CSR_MCOUNTINHIBIT>::clear(0xD);
+#endif
+}
+
+uint32_t Profiler::register_probe(ProfileProbe* probe) {
+    // Probes in ISRs register on their first sample, so mask interrupts
+    // while claiming a slot from the main loop
+    InterruptGuard guard;
+    if (probe_total == MAX_PROBES) {
+        return ProfileProbe::UNREGISTERED;
+    }
+    probes[probe_total] = probe;
+    return probe_total++;
+}
+
+void Profiler::reset() {
+    for (uint32_t id = 0; id < probe_count(); id++) {
+        InterruptGuard guard;
+        probes[id]->reset();
+    }
+}
+
+static void print_padded(const char* text, uint32_t width) {
+    uint32_t len = 0;
+    while (text[len]) len++;
+    uart::puts(text);
+    while (len++ < width) uart::putchar(' ');
+}
+
+void Profiler::report() {
+    uart::puts("=== Profile (cycles) ===\n");
+#if !PROFILE_ENABLED
+    uart::puts("   Profiling disabled (PROFILE=0)\n");
+#endif
+
+    for (uint32_t id = 0; id < probe_count(); id++) {
+        // Snapshot so an ISR probe can't change under the report
+        ProfileProbe probe("");
+        {
+            InterruptGuard guard;
+            probe = *probes[id];
+        }
+
+        uart::puts("   ");
+        print_padded(probe.name(), 28);
+        uart::puts(" n=");
+        uart::print_number(probe.count());
+        uart::puts(" min=");
+        uart::print_number(probe.min_cycles());
+        uart::puts(" avg=");
+        uart::print_number(probe.avg_cycles());
+        uart::puts(" p99=");
+        uart::print_number(probe.percentile_cycles(99));
+        uart::puts(" max=");
+        uart::print_number(probe.max_cycles());
+        uart::puts(" instret=");
+        uart::print_number(probe.avg_instret());
+#if PROFILE_HPM_EVENT
+        uart::puts(" hpm3=");
+        uart::print_number(probe.avg_events());
+#endif
+        uart::puts("\n");
+    }
+}
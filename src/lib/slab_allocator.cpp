@@ -0,0 +1,94 @@
+#include "slab_allocator.h"
+#include "placement.h"
+
+// Static member definitions
+HOT_DATA SlabAllocator::SizeClass SlabAllocator::classes[CLASS_COUNT] = {
+    {nullptr, 8, 0, 0, 0},
+    {nullptr, 12, 0, 0, 0},
+    {nullptr, 16, 0, 0, 0},
+    {nullptr, 24, 0, 0, 0},
+    {nullptr, 32, 0, 0, 0},
+    {nullptr, 48, 0, 0, 0},
+    {nullptr, 64, 0, 0, 0},
+    {nullptr, 96, 0, 0, 0},
+    {nullptr, 128, 0, 0, 0},
+};
+
+HOT_CODE SlabAllocator::SizeClass* SlabAllocator::class_for(size_t size) {
+    // Class index for each 4-byte step up to MAX_OBJECT_SIZE
+    static const uint8_t class_index[MAX_OBJECT_SIZE / 4 + 1] = {
+        0, 0, 0, 1, 2, 3, 3, 4, 4,
+        5, 5, 5, 5, 6, 6, 6, 6,
+        7, 7, 7, 7, 7, 7, 7, 7,
+        8, 8, 8, 8, 8, 8, 8, 8,
+    };
+    static_assert(sizeof(FreeObject) <= 8, "smallest class must hold a free-list link");
+    if (size > MAX_OBJECT_SIZE) {
+        return nullptr;
+    }
+    return &classes[class_index[(size + 3) / 4]];
+}
+
+bool SlabAllocator::refill(SizeClass& size_class) {
+    uint8_t* slab = static_cast<uint8_t*>(::operator new(SLAB_BYTES));
+    if (!slab) {
+        return false;
+    }
+
+    // Thread the slots in address order so consecutive allocations are adjacent
+    uint32_t count = SLAB_BYTES / size_class.object_size;
+    FreeObject* head = size_class.free_list;
+    for (uint32_t i = count; i > 0; --i) {
+        FreeObject* object = reinterpret_cast<FreeObject*>(slab + (i - 1) * size_class.object_size);
+        object->next = head;
+        head = object;
+    }
+    size_class.free_list = head;
+    size_class.slab_count++;
+    return true;
+}
+
+HOT_CODE void* SlabAllocator::allocate(size_t size) {
+    SizeClass* size_class = class_for(size);
+    if (!size_class) {
+        return ::operator new(size);
+    }
+
+    if (!size_class->free_list && !refill(*size_class)) {
+        return nullptr;
+    }
+
+    FreeObject* object = size_class->free_list;
+    size_class->free_list = object->next;
+    size_class->in_use++;
+    if (size_class->in_use > size_class->peak_in_use) {
+        size_class->peak_in_use = size_class->in_use;
+    }
+    return object;
+}
+
+HOT_CODE void SlabAllocator::deallocate(void* ptr, size_t size) {
+    if (!ptr) return;
+
+    SizeClass* size_class = class_for(size);
+    if (!size_class) {
+        ::operator delete(ptr, size);
+        return;
+    }
+
+    FreeObject* object = static_cast<FreeObject*>(ptr);
+    object->next = size_class->free_list;
+    size_class->free_list = object;
+    size_class->in_use--;
+}
+
+SlabAllocator::ClassStats SlabAllocator::get_class_stats(uint32_t index) {
+    const SizeClass& size_class = classes[index];
+    ClassStats stats;
+    stats.object_size = size_class.object_size;
+    stats.slab_count = size_class.slab_count;
+    stats.capacity = size_class.slab_count * (SLAB_BYTES / size_class.object_size);
+    stats.in_use = size_class.in_use;
+    stats.peak_in_use = size_class.peak_in_use;
+    return stats;
+}
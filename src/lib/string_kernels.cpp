@@ -0,0 +1,218 @@
+#include "string_kernels.h"
+#include "vector_kernels.h"
+
+#if VECTOR_KERNELS_RVV
+#include "interrupt.h"
+#include <riscv_vector.h>
+#endif
+
+// Word accesses to byte buffers: may_alias keeps them legal under strict
+// aliasing, the same way libc implementations do it
+typedef uint32_t __attribute__((__may_alias__)) word_t;
+
+static constexpr uintptr_t WORD_MASK = sizeof(word_t) - 1;
+static constexpr uint32_t ONES = 0x01010101u;
+static constexpr uint32_t HIGHS = 0x80808080u;
+
+// Non-zero iff some byte of the word is zero
+static inline uint32_t has_zero_byte(uint32_t word) {
+    return (word - ONES) & ~word & HIGHS;
+}
+
+void* StringKernels::copy_bytes(void* dst, const void* src, size_t count) {
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+    while (count--) {
+        *d++ = *s++;
+    }
+    return dst;
+}
+
+void* StringKernels::set_bytes(void* dst, int value, size_t count) {
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    while (count--) {
+        *d++ = (uint8_t)value;
+    }
+    return dst;
+}
+
+size_t StringKernels::length_bytes(const char* str) {
+    const char* end = str;
+    while (*end) {
+        end++;
+    }
+    return end - str;
+}
+
+#if VECTOR_KERNELS_RVV
+
+// Vector registers are not saved on traps or task switches, so each strip
+// runs with interrupts masked (see vector_kernels.h)
+static void vector_copy(uint8_t* d, const uint8_t* s, size_t count) {
+    while (count) {
+        InterruptGuard guard;
+        size_t vl = __riscv_vsetvl_e8m8(count);
+        __riscv_vse8_v_u8m8(d, __riscv_vle8_v_u8m8(s, vl), vl);
+        d += vl;
+        s += vl;
+        count -= vl;
+    }
+}
+
+static void vector_set(uint8_t* d, uint8_t value, size_t count) {
+    while (count) {
+        InterruptGuard guard;
+        size_t vl = __riscv_vsetvl_e8m8(count);
+        __riscv_vse8_v_u8m8(d, __riscv_vmv_v_x_u8m8(value, vl), vl);
+        d += vl;
+        count -= vl;
+    }
+}
+
+// Fault-only-first loads stop at the end of accessible memory instead of
+// trapping, so reading ahead of the terminator is safe
+static size_t vector_length(const char* str) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(str);
+    for (;;) {
+        InterruptGuard guard;
+        size_t vl = __riscv_vsetvlmax_e8m8();
+        vuint8m8_t bytes = __riscv_vle8ff_v_u8m8(p, &vl, vl);
+        long zero = __riscv_vfirst_m_b1(__riscv_vmseq_vx_u8m8_b1(bytes, 0, vl), vl);
+        if (zero >= 0) {
+            return (p + zero) - reinterpret_cast<const uint8_t*>(str);
+        }
+        p += vl;
+    }
+}
+
+#endif
+
+extern "C" {
+
+void* memcpy(void* __restrict dst, const void* __restrict src, size_t count) {
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    const uint8_t* s = static_cast<const uint8_t*>(src);
+
+    if (count < StringKernels::SMALL_SIZE) {
+        while (count--) *d++ = *s++;
+        return dst;
+    }
+#if VECTOR_KERNELS_RVV
+    if (count >= StringKernels::VECTOR_THRESHOLD && VectorKernels::vector_enabled()) {
+        vector_copy(d, s, count);
+        return dst;
+    }
+#endif
+
+    while ((uintptr_t)d & WORD_MASK) {
+        *d++ = *s++;
+        count--;
+    }
+
+    word_t* wd = reinterpret_cast<word_t*>(d);
+    uintptr_t offset = (uintptr_t)s & WORD_MASK;
+    if (!offset) {
+        const word_t* ws = reinterpret_cast<const word_t*>(s);
+        for (; count >= 32; count -= 32, wd += 8, ws += 8) {
+            uint32_t w0 = ws[0], w1 = ws[1], w2 = ws[2], w3 = ws[3];
+            uint32_t w4 = ws[4], w5 = ws[5], w6 = ws[6], w7 = ws[7];
+            wd[0] = w0; wd[1] = w1; wd[2] = w2; wd[3] = w3;
+            wd[4] = w4; wd[5] = w5; wd[6] = w6; wd[7] = w7;
+        }
+        for (; count >= 4; count -= 4) {
+            *wd++ = *ws++;
+        }
+        s = reinterpret_cast<const uint8_t*>(ws);
+    } else {
+        // Misaligned source: aligned word loads, each output word built
+        // from two neighbours (little endian). The words read never extend
+        // past the aligned word holding the last byte copied.
+        const word_t* ws = reinterpret_cast<const word_t*>(s - offset);
+        uint32_t low = offset * 8;
+        uint32_t high = 32 - low;
+        uint32_t previous = *ws++;
+        for (; count >= 16; count -= 16, wd += 4, ws += 4) {
+            uint32_t w0 = ws[0], w1 = ws[1], w2 = ws[2], w3 = ws[3];
+            wd[0] = (previous >> low) | (w0 << high);
+            wd[1] = (w0 >> low) | (w1 << high);
+            wd[2] = (w1 >> low) | (w2 << high);
+            wd[3] = (w2 >> low) | (w3 << high);
+            previous = w3;
+        }
+        for (; count >= 4; count -= 4) {
+            uint32_t next = *ws++;
+            *wd++ = (previous >> low) | (next << high);
+            previous = next;
+        }
+        s = reinterpret_cast<const uint8_t*>(ws) - sizeof(word_t) + offset;
+    }
+
+    d = reinterpret_cast<uint8_t*>(wd);
+    while (count--) *d++ = *s++;
+    return dst;
+}
+
+void* memset(void* dst, int value, size_t count) {
+    uint8_t* d = static_cast<uint8_t*>(dst);
+    uint8_t byte = (uint8_t)value;
+
+    if (count < StringKernels::SMALL_SIZE) {
+        while (count--) *d++ = byte;
+        return dst;
+    }
+#if VECTOR_KERNELS_RVV
+    if (count >= StringKernels::VECTOR_THRESHOLD && VectorKernels::vector_enabled()) {
+        vector_set(d, byte, count);
+        return dst;
+    }
+#endif
+
+    while ((uintptr_t)d & WORD_MASK) {
+        *d++ = byte;
+        count--;
+    }
+
+    uint32_t pattern = byte * ONES;
+    word_t* wd = reinterpret_cast<word_t*>(d);
+    for (; count >= 32; count -= 32, wd += 8) {
+        wd[0] = pattern; wd[1] = pattern; wd[2] = pattern; wd[3] = pattern;
+        wd[4] = pattern; wd[5] = pattern; wd[6] = pattern; wd[7] = pattern;
+    }
+    for (; count >= 4; count -= 4) {
+        *wd++ = pattern;
+    }
+
+    d = reinterpret_cast<uint8_t*>(wd);
+    while (count--) *d++ = byte;
+    return dst;
+}
+
+size_t strlen(const char* str) {
+#if VECTOR_KERNELS_RVV
+    if (VectorKernels::vector_enabled()) {
+        return vector_length(str);
+    }
+#endif
+    const char* p = str;
+    while ((uintptr_t)p & WORD_MASK) {
+        if (!*p) return p - str;
+        p++;
+    }
+
+    // Aligned words never cross into memory the string does not touch;
+    // two per iteration, then find the zero byte in the word that has it
+    const word_t* w = reinterpret_cast<const word_t*>(p);
+    for (;;) {
+        if (has_zero_byte(w[0])) break;
+        if (has_zero_byte(w[1])) {
+            w++;
+            break;
+        }
+        w += 2;
+    }
+    p = reinterpret_cast<const char*>(w);
+    while (*p) p++;
+    return p - str;
+}
+
+}
@@ -0,0 +1,257 @@
+#include "tlsf_heap.h"
+#include "placement.h"
+
+namespace {
+
+// Index of the most significant set bit
+inline uint32_t fls(size_t value) {
+    if (sizeof(size_t) == 8) {
+        return 63 - __builtin_clzll(value);
+    }
+    return 31 - __builtin_clz(static_cast<uint32_t>(value));
+}
+
+// Index of the least significant set bit
+inline uint32_t ffs(uint32_t value) {
+    return __builtin_ctz(value);
+}
+
+inline size_t align_up(size_t value, size_t align) {
+    return (value + align - 1) & ~(align - 1);
+}
+
+}
+
+void TlsfHeap::init(void* start, size_t size) {
+    fl_bitmap = 0;
+    for (uint32_t fl = 0; fl < FL_INDEX_COUNT; ++fl) {
+        sl_bitmap[fl] = 0;
+        for (uint32_t sl = 0; sl < SL_INDEX_COUNT; ++sl) {
+            free_lists[fl][sl] = nullptr;
+        }
+    }
+    free_bytes = 0;
+    stats = Stats{0, 0, 0, 0, 0, 0, 0, 0};
+
+    // Trim the region to aligned bounds
+    uintptr_t begin = align_up(reinterpret_cast<uintptr_t>(start), ALIGN_SIZE);
+    uintptr_t end = (reinterpret_cast<uintptr_t>(start) + size) & ~(uintptr_t)(ALIGN_SIZE - 1);
+    region_start = reinterpret_cast<uint8_t*>(begin);
+    region_end = region_start;
+
+    // Need room for one block header, its minimum payload and the end sentinel
+    if (end <= begin || end - begin < 2 * HEADER_SIZE + MIN_BLOCK_SIZE) {
+        return;
+    }
+
+    size_t payload = (end - begin) - 2 * HEADER_SIZE;
+    if (payload > MAX_BLOCK_SIZE - ALIGN_SIZE) {
+        payload = MAX_BLOCK_SIZE - ALIGN_SIZE;
+    }
+    region_end = region_start + payload + 2 * HEADER_SIZE;
+    stats.total_bytes = region_end - region_start;
+
+    Block* first = reinterpret_cast<Block*>(region_start);
+    first->prev_phys = nullptr;
+    first->size_flags = payload | BLOCK_FREE;
+
+    // Zero-sized, permanently used sentinel stops coalescing at the end
+    Block* sentinel = next_phys(first);
+    sentinel->prev_phys = first;
+    sentinel->size_flags = 0;
+
+    insert_free(first);
+}
+
+HOT_CODE void TlsfHeap::mapping_insert(size_t size, uint32_t& fl, uint32_t& sl) {
+    if (size < SMALL_BLOCK_SIZE) {
+        // Small sizes are spread linearly across the first list
+        fl = 0;
+        sl = static_cast<uint32_t>(size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT));
+    } else {
+        uint32_t msb = fls(size);
+        sl = static_cast<uint32_t>(size >> (msb - SL_INDEX_COUNT_LOG2)) ^ SL_INDEX_COUNT;
+        fl = msb - (FL_INDEX_SHIFT - 1);
+    }
+}
+
+HOT_CODE void TlsfHeap::mapping_search(size_t size, uint32_t& fl, uint32_t& sl) {
+    // Round up to the next list boundary so any block found is large enough
+    if (size >= SMALL_BLOCK_SIZE) {
+        size += (size_t(1) << (fls(size) - SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+HOT_CODE TlsfHeap::Block* TlsfHeap::find_suitable(uint32_t& fl, uint32_t& sl) const {
+    uint32_t sl_map = sl_bitmap[fl] & (~0u << sl);
+    if (!sl_map) {
+        uint32_t fl_map = fl_bitmap & (~0u << (fl + 1));
+        if (!fl_map) {
+            return nullptr;
+        }
+        fl = ffs(fl_map);
+        sl_map = sl_bitmap[fl];
+    }
+    sl = ffs(sl_map);
+    return free_lists[fl][sl];
+}
+
+HOT_CODE void TlsfHeap::insert_free(Block* block) {
+    uint32_t fl, sl;
+    mapping_insert(block_size(block), fl, sl);
+
+    Block* head = free_lists[fl][sl];
+    block->next_free = head;
+    block->prev_free = nullptr;
+    if (head) {
+        head->prev_free = block;
+    }
+    free_lists[fl][sl] = block;
+
+    fl_bitmap |= 1u << fl;
+    sl_bitmap[fl] |= 1u << sl;
+    free_bytes += block_size(block);
+}
+
+HOT_CODE void TlsfHeap::remove_free(Block* block) {
+    uint32_t fl, sl;
+    mapping_insert(block_size(block), fl, sl);
+
+    if (block->prev_free) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        free_lists[fl][sl] = block->next_free;
+    }
+    if (block->next_free) {
+        block->next_free->prev_free = block->prev_free;
+    }
+
+    if (!free_lists[fl][sl]) {
+        sl_bitmap[fl] &= ~(1u << sl);
+        if (!sl_bitmap[fl]) {
+            fl_bitmap &= ~(1u << fl);
+        }
+    }
+    free_bytes -= block_size(block);
+}
+
+HOT_CODE TlsfHeap::Block* TlsfHeap::merge_with_next(Block* block) {
+    Block* next = next_phys(block);
+    size_t merged = block_size(block) + HEADER_SIZE + block_size(next);
+    block->size_flags = merged | (block->size_flags & BLOCK_FREE);
+    next_phys(block)->prev_phys = block;
+    return block;
+}
+
+HOT_CODE void TlsfHeap::split(Block* block, size_t size) {
+    size_t available = block_size(block);
+    if (available < size + HEADER_SIZE + MIN_BLOCK_SIZE) {
+        return;
+    }
+
+    Block* rest = reinterpret_cast<Block*>(static_cast<uint8_t*>(to_payload(block)) + size);
+    rest->prev_phys = block;
+    rest->size_flags = (available - size - HEADER_SIZE) | BLOCK_FREE;
+    next_phys(rest)->prev_phys = rest;
+
+    block->size_flags = size | (block->size_flags & BLOCK_FREE);
+    insert_free(rest);
+}
+
+HOT_CODE bool TlsfHeap::owns(const void* ptr) const {
+    const uint8_t* p = static_cast<const uint8_t*>(ptr);
+    return p >= region_start + HEADER_SIZE && p < region_end &&
+           (reinterpret_cast<uintptr_t>(p) & (ALIGN_SIZE - 1)) == 0;
+}
+
+HOT_CODE void* TlsfHeap::allocate(size_t size) {
+    size_t adjusted = align_up(size ? size : 1, ALIGN_SIZE);
+    if (adjusted < MIN_BLOCK_SIZE) {
+        adjusted = MIN_BLOCK_SIZE;
+    }
+    if (adjusted < size || adjusted >= MAX_BLOCK_SIZE) {
+        stats.failed_count++;
+        return nullptr;
+    }
+
+    uint32_t fl, sl;
+    mapping_search(adjusted, fl, sl);
+    Block* block = fl < FL_INDEX_COUNT ? find_suitable(fl, sl) : nullptr;
+    if (!block) {
+        stats.failed_count++;
+        return nullptr;
+    }
+
+    remove_free(block);
+    split(block, adjusted);
+    block->size_flags &= ~BLOCK_FREE;
+
+    stats.alloc_count++;
+    stats.used_bytes += block_size(block);
+    if (stats.used_bytes > stats.peak_used_bytes) {
+        stats.peak_used_bytes = stats.used_bytes;
+    }
+    size_t block_end = reinterpret_cast<uint8_t*>(next_phys(block)) - region_start;
+    if (block_end > stats.high_water_bytes) {
+        stats.high_water_bytes = block_end;
+    }
+
+    return to_payload(block);
+}
+
+HOT_CODE void TlsfHeap::deallocate(void* ptr) {
+    if (!ptr) return;
+
+    Block* block = from_payload(ptr);
+    if (!owns(ptr) || is_free(block)) {
+        stats.bad_free_count++;
+        return;
+    }
+
+    stats.free_count++;
+    stats.used_bytes -= block_size(block);
+    block->size_flags |= BLOCK_FREE;
+
+    // Coalesce with both physical neighbours so free space never fragments
+    // into adjacent free blocks
+    Block* prev = block->prev_phys;
+    if (prev && is_free(prev)) {
+        remove_free(prev);
+        block = merge_with_next(prev);
+    }
+    Block* next = next_phys(block);
+    if (is_free(next)) {
+        remove_free(next);
+        merge_with_next(block);
+    }
+
+    insert_free(block);
+}
+
+HOT_CODE void TlsfHeap::deallocate(void* ptr, size_t size) {
+    if (ptr && owns(ptr) && !is_free(from_payload(ptr)) && size > usable_size(ptr)) {
+        // The header is authoritative; record the caller's mismatch and free anyway
+        stats.bad_free_count++;
+    }
+    deallocate(ptr);
+}
+
+size_t TlsfHeap::usable_size(const void* ptr) {
+    return ptr ? block_size(from_payload(ptr)) : 0;
+}
+
+size_t TlsfHeap::get_largest_free_block() const {
+    if (!fl_bitmap) return 0;
+
+    // The largest block always lives in the highest populated list
+    uint32_t fl = fls(fl_bitmap);
+    uint32_t sl = fls(sl_bitmap[fl]);
+    size_t largest = 0;
+    for (Block* block = free_lists[fl][sl]; block; block = block->next_free) {
+        if (block_size(block) > largest) {
+            largest = block_size(block);
+        }
+    }
+    return largest;
+}
@@ -0,0 +1,112 @@
+#include "vector_kernels.h"
+#include "interrupt.h"
+
+#if VECTOR_KERNELS_RVV
+#include <riscv_vector.h>
+#endif
+
+#define MISA_V              (1u << ('V' - 'A'))
+#define MSTATUS_VS_MASK     (3u << 9)
+
+// Static member definitions
+bool VectorKernels::use_vector = false;
+
+void VectorKernels::init() {
+    // start.S sets mstatus.VS on every hart; it reads back as zero (Off)
+    // where there is no vector unit
+    use_vector = VECTOR_KERNELS_RVV &&
+                 (csr<CSR_MISA>::read() & MISA_V) &&
+                 (csr<CSR_MSTATUS>::read() & MSTATUS_VS_MASK);
+}
+
+void VectorKernels::map_affine_scalar(int32_t* dst, const int32_t* src, size_t count,
+                                      int32_t multiplier, int32_t addend) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = src[i] * multiplier + addend;
+    }
+}
+
+void VectorKernels::fill_scalar(int32_t* dst, size_t count, int32_t value) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = value;
+    }
+}
+
+int64_t VectorKernels::sum_scalar(const int32_t* src, size_t count) {
+    int64_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += src[i];
+    }
+    return total;
+}
+
+#if VECTOR_KERNELS_RVV
+
+void VectorKernels::map_affine(int32_t* dst, const int32_t* src, size_t count,
+                               int32_t multiplier, int32_t addend) {
+    if (!use_vector) {
+        map_affine_scalar(dst, src, count, multiplier, addend);
+        return;
+    }
+    while (count) {
+        InterruptGuard guard;
+        size_t vl = __riscv_vsetvl_e32m8(count);
+        vint32m8_t values = __riscv_vle32_v_i32m8(src, vl);
+        values = __riscv_vmul_vx_i32m8(values, multiplier, vl);
+        values = __riscv_vadd_vx_i32m8(values, addend, vl);
+        __riscv_vse32_v_i32m8(dst, values, vl);
+        src += vl;
+        dst += vl;
+        count -= vl;
+    }
+}
+
+void VectorKernels::fill(int32_t* dst, size_t count, int32_t value) {
+    if (!use_vector) {
+        fill_scalar(dst, count, value);
+        return;
+    }
+    while (count) {
+        InterruptGuard guard;
+        size_t vl = __riscv_vsetvl_e32m8(count);
+        __riscv_vse32_v_i32m8(dst, __riscv_vmv_v_x_i32m8(value, vl), vl);
+        dst += vl;
+        count -= vl;
+    }
+}
+
+// Widening reduction straight into a 64-bit accumulator element
+int64_t VectorKernels::sum(const int32_t* src, size_t count) {
+    if (!use_vector) {
+        return sum_scalar(src, count);
+    }
+    int64_t total = 0;
+    while (count) {
+        InterruptGuard guard;
+        size_t vl = __riscv_vsetvl_e32m8(count);
+        vint32m8_t values = __riscv_vle32_v_i32m8(src, vl);
+        vint64m1_t accumulator = __riscv_vmv_s_x_i64m1(total, 1);
+        accumulator = __riscv_vwredsum_vs_i32m8_i64m1(values, accumulator, vl);
+        total = __riscv_vmv_x_s_i64m1_i64(accumulator);
+        src += vl;
+        count -= vl;
+    }
+    return total;
+}
+
+#else
+
+void VectorKernels::map_affine(int32_t* dst, const int32_t* src, size_t count,
+                               int32_t multiplier, int32_t addend) {
+    map_affine_scalar(dst, src, count, multiplier, addend);
+}
+
+void VectorKernels::fill(int32_t* dst, size_t count, int32_t value) {
+    fill_scalar(dst, count, value);
+}
+
+int64_t VectorKernels::sum(const int32_t* src, size_t count) {
+    return sum_scalar(src, count);
+}
+
+#endif
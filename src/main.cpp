@@ -16,76 +16,91 @@ typedef long double max_align_t;
 #include <map>
 #include <vector>
 #include "simple_map.h"
+#include "hash_map.h"
+#include "flat_map.h"
+#include "ring_deque.h"
+#include "small_vector.h"
 #include "simple_list.h"
+#include "slab_allocator.h"
 #include "uart.h"
+#include "uart_driver.h"
+#include "clint_timer.h"
+#include "plic.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "smp.h"
+#include "spinlock.h"
+#include "parallel.h"
+#include "vector_kernels.h"
+#include "binlog.h"
+#include "boot.h"
+#include <utility>
 #include <interrupt.h>
 #include <interrupt.h>
 
 void test_stdlib_functions() {
-    uart::puts("=== Testing Standard Library Functions ===\n");
+    PROFILE_SCOPE("test_stdlib_functions");
+    LOG("=== Testing Standard Library Functions ===\n");
     
     // Test malloc/free
-    uart::puts("1. Testing malloc/free:\n");
+    LOG("1. Testing malloc/free:\n");
     void* ptr = malloc(100);
     if (ptr) {
-        uart::puts("   malloc(100) successful\n");
+        LOG("   malloc(100) successful\n");
         free(ptr);
-        uart::puts("   free() successful\n");
+        LOG("   free() successful\n");
     }
     
     // Test string functions
-    uart::puts("2. Testing string functions:\n");
+    LOG("2. Testing string functions:\n");
     char str1[50] = "Hello";
     char str2[50] = " World";
     char combined[100];
     
     strcpy(combined, str1);
     strcat(combined, str2);
+    // Formatting is deferred, so print the stack buffer directly
+    BinLog::flush();
     uart::puts("   strcpy + strcat result: ");
     uart::puts(combined);
-    uart::puts("\n   Length: ");
-    // uart::print_number(strlen(combined));
-    uart::puts("\n");
+    LOG("\n   Length: %u\n", strlen(combined));
  
     // Test memory functions
-    uart::puts("3. Testing memory functions:\n");
+    LOG("3. Testing memory functions:\n");
     int numbers[5] = {1, 2, 3, 4, 5};
     int copy[5];
     memcpy(copy, numbers, sizeof(numbers));
-    uart::puts("   memcpy result: [");
+    LOG("   memcpy result: [");
     for (int i = 0; i < 5; i++) {
-        uart::print_number(copy[i]);
-        if (i < 4) uart::puts(", ");
+        LOG("%d%s", copy[i], i < 4 ? ", " : "");
     }
-    uart::puts("]\n");
+    LOG("]\n");
     
     // Test math functions
-    uart::puts("4. Testing math functions:\n");
+    LOG("4. Testing math functions:\n");
     double x = 4.0;
-    uart::puts("   sqrt(4.0) = ");
-    uart::print_number((int)sqrt(x));
-    uart::puts("\n   abs(-42) = ");
-    uart::print_number(abs(-42));
-    uart::puts("\n");
+    LOG("   sqrt(4.0) = %d\n", (int)sqrt(x));
+    LOG("   abs(-42) = %d\n", abs(-42));
 }
 
 class SampleClass {
 public:
     SampleClass() {
-        uart::puts("SampleClass constructor called\n");
+        LOG("SampleClass constructor called\n");
     }
     
     void print() {
-        uart::puts("SampleClass instance created\n");
+        LOG("SampleClass instance created\n");
     }
 };
 
 
 void test_class_functions(){
-    uart::puts("=== Testing Class Functions ===\n");
+    PROFILE_SCOPE("test_class_functions");
+    LOG("=== Testing Class Functions ===\n");
     
     // Test class functions
-    uart::puts("1. Testing class functions:\n");
+    LOG("1. Testing class functions:\n");
     SampleClass obj;
     obj.print();
 
@@ -95,229 +110,928 @@ void test_class_functions(){
 }
 
 void test_map_functions(){
-    uart::puts("=== Testing Map Functions ===\n");
+    PROFILE_SCOPE("test_map_functions");
+    LOG("=== Testing Map Functions ===\n");
     
-    uart::puts("1. Testing SimpleMap (std::map alternative):\n");
-    uart::puts("   Creating map...\n");
+    LOG("1. Testing SimpleMap (std::map alternative):\n");
+    LOG("   Creating map...\n");
     
     SimpleMap<int, int> map;
-    uart::puts("   Map created\n");
+    LOG("   Map created\n");
     
-    uart::puts("   Using operator[] - map[1] = 1...\n");
+    LOG("   Using operator[] - map[1] = 1...\n");
     map[1] = 1;
-    uart::puts("   Element inserted using operator[]\n");
+    LOG("   Element inserted using operator[]\n");
     
-    uart::puts("   Map size: ");
-    uart::print_number(map.size());
-    uart::puts("\n");
+    LOG("   Map size: %u\n", map.size());
     
-    uart::puts("   Using operator[] - map[2] = 2...\n");
+    LOG("   Using operator[] - map[2] = 2...\n");
     map[2] = 2;
-    uart::puts("   Second element inserted using operator[]\n");
+    LOG("   Second element inserted using operator[]\n");
     
-    uart::puts("   Map size: ");
-    uart::print_number(map.size());
-    uart::puts("\n");
+    LOG("   Map size: %u\n", map.size());
     
-    uart::puts("   Using operator[] - map[3] = 3...\n");
+    LOG("   Using operator[] - map[3] = 3...\n");
     map[3] = 3;
-    uart::puts("   Third element inserted using operator[]\n");
+    LOG("   Third element inserted using operator[]\n");
     
-    uart::puts("   Map size: ");
-    uart::print_number(map.size());
-    uart::puts("\n");
+    LOG("   Map size: %u\n", map.size());
     
-    uart::puts("   Testing retrieval - map[2] = ");
-    uart::print_number(map[2]);
-    uart::puts("\n");
+    LOG("   Testing retrieval - map[2] = %d\n", map[2]);
     
-    uart::puts("   Testing modification - map[2] = 20...\n");
+    LOG("   Testing modification - map[2] = 20...\n");
     map[2] = 20;
-    uart::puts("   Value modified using operator[]\n");
+    LOG("   Value modified using operator[]\n");
     
-    uart::puts("   Verifying modification - map[2] = ");
-    uart::print_number(map[2]);
-    uart::puts("\n");
+    LOG("   Verifying modification - map[2] = %d\n", map[2]);
     
-    uart::puts("   Testing emplace_back - map.emplace_back(4, 40)...\n");
+    LOG("   Testing emplace_back - map.emplace_back(4, 40)...\n");
     map.emplace_back(4, 40);
-    uart::puts("   Element emplaced successfully\n");
+    LOG("   Element emplaced successfully\n");
     
-    uart::puts("   Map size after emplace_back: ");
-    uart::print_number(map.size());
-    uart::puts("\n");
+    LOG("   Map size after emplace_back: %u\n", map.size());
     
-    uart::puts("   Verifying emplaced value - map[4] = ");
-    uart::print_number(map[4]);
-    uart::puts("\n");
+    LOG("   Verifying emplaced value - map[4] = %d\n", map[4]);
     
-    uart::puts("   Testing map iteration:\n");
-    uart::puts("   Iterating through all elements:\n");
+    LOG("   Testing map iteration:\n");
+    LOG("   Iterating through all elements:\n");
     for (auto it = map.begin(); it != map.end(); ++it) {
-        uart::puts("   Key: ");
-        uart::print_number(it.key());
-        uart::puts(", Value: ");
-        uart::print_number(it.value());
-        uart::puts("\n");
+        LOG("   Key: %d, Value: %d\n", it.key(), it.value());
     }
     
-    uart::puts("   Testing find_iter method:\n");
+    LOG("   Testing find_iter method:\n");
     auto found_it = map.find_iter(2);
     if (found_it != map.end()) {
-        uart::puts("   Found key 2 with value: ");
-        uart::print_number(found_it.value());
-        uart::puts("\n");
+        LOG("   Found key 2 with value: %d\n", found_it.value());
     } else {
-        uart::puts("   Key 2 not found\n");
+        LOG("   Key 2 not found\n");
     }
     
-    uart::puts("   Testing find_iter for non-existent key:\n");
+    LOG("   Testing find_iter for non-existent key:\n");
     auto not_found_it = map.find_iter(99);
     if (not_found_it != map.end()) {
-        uart::puts("   Found key 99 with value: ");
-        uart::print_number(not_found_it.value());
-        uart::puts("\n");
+        LOG("   Found key 99 with value: %d\n", not_found_it.value());
     } else {
-        uart::puts("   Key 99 not found (as expected)\n");
+        LOG("   Key 99 not found (as expected)\n");
     }
     
-    uart::puts("   Testing iterator modification:\n");
+    LOG("   Testing iterator modification:\n");
     auto modify_it = map.find_iter(3);
     if (modify_it != map.end()) {
-        uart::puts("   Original value for key 3: ");
-        uart::print_number(modify_it.value());
-        uart::puts("\n");
+        LOG("   Original value for key 3: %d\n", modify_it.value());
         
         modify_it.value() = 300;
-        uart::puts("   Modified value for key 3: ");
-        uart::print_number(modify_it.value());
-        uart::puts("\n");
+        LOG("   Modified value for key 3: %d\n", modify_it.value());
         
-        uart::puts("   Verifying modification via map[3]: ");
-        uart::print_number(map[3]);
-        uart::puts("\n");
+        LOG("   Verifying modification via map[3]: %d\n", map[3]);
+    }
+    
+    LOG("   Map test completed successfully\n");
+}
+
+void test_hash_map_functions() {
+    PROFILE_SCOPE("test_hash_map_functions");
+    LOG("=== Testing Hash Map Functions ===\n");
+    
+    LOG("1. Testing HashMap (open addressing):\n");
+    HashMap<int, int> map;
+    
+    LOG("   Inserting 100 keys with operator[]...\n");
+    for (int i = 0; i < 100; i++) {
+        map[i] = i * 10;
+    }
+    LOG("   Map size: %u, capacity: %u\n", map.size(), map.capacity());
+    
+    LOG("   Testing retrieval - map[42] = %d\n", map[42]);
+    
+    LOG("   Testing emplace_back - map.emplace_back(7, 700)...\n");
+    map.emplace_back(7, 700);
+    LOG("   Verifying emplaced value - map[7] = %d\n", map[7]);
+    
+    LOG("   Testing erase of even keys...\n");
+    for (int i = 0; i < 100; i += 2) {
+        map.erase(i);
     }
+    LOG("   Map size after erase: %u\n", map.size());
+    
+    LOG("   Testing find for erased key 42: %s\n",
+        map.find(42) ? "found (unexpected)" : "not found (as expected)");
     
-    uart::puts("   Map test completed successfully\n");
+    LOG("   Testing find_iter for key 43: ");
+    auto it = map.find_iter(43);
+    if (it != map.end()) {
+        LOG("%d", it.value());
+    }
+    LOG("\n");
+    
+    LOG("   Summing values by iteration: ");
+    uint32_t sum = 0;
+    for (auto iter = map.begin(); iter != map.end(); ++iter) {
+        sum += iter.value();
+    }
+    LOG("%u\n", sum);
+    
+    LOG("   Hash map test completed successfully\n");
+}
+
+void test_flat_map_functions() {
+    PROFILE_SCOPE("test_flat_map_functions");
+    LOG("=== Testing Flat Map Functions ===\n");
+    
+    LOG("1. Testing FlatMap (sorted array):\n");
+    FlatMap<int, int> map;
+    map.reserve(8);
+    
+    LOG("   Inserting keys 30, 10, 20 out of order...\n");
+    map[30] = 300;
+    map[10] = 100;
+    map.insert(20, 200);
+    
+    LOG("   Bulk loading sorted keys 5, 15, 25...\n");
+    FlatMap<int, int>::Entry bulk[] = {{5, 50}, {15, 150}, {25, 250}};
+    map.insert_sorted_range(bulk, bulk + 3);
+    
+    LOG("   Map size: %u\n", map.size());
+    
+    LOG("   Iterating in key order:\n");
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        LOG("   Key: %d, Value: %d\n", it.key(), it.value());
+    }
+    
+    LOG("   Testing find_iter for key 25: ");
+    auto found_it = map.find_iter(25);
+    if (found_it != map.end()) {
+        LOG("%d", found_it.value());
+    }
+    LOG("\n");
+    
+    LOG("   Testing erase of key 10...\n");
+    map.erase(10);
+    LOG("   New first key: %d\n", map.begin().key());
+    
+    LOG("   Flat map test completed successfully\n");
 }
 
 void test_list_functions() {
-    uart::puts("=== Testing List Functions ===\n");
+    PROFILE_SCOPE("test_list_functions");
+    LOG("=== Testing List Functions ===\n");
     
-    uart::puts("1. Testing SimpleList (std::list alternative):\n");
-    uart::puts("   Creating list...\n");
+    LOG("1. Testing SimpleList (std::list alternative):\n");
+    LOG("   Creating list...\n");
     
     SimpleList<int> list;
-    uart::puts("   List created\n");
+    LOG("   List created\n");
     
-    uart::puts("   Testing push_back...\n");
+    LOG("   Testing push_back...\n");
     list.push_back(10);
     list.push_back(20);
     list.push_back(30);
-    uart::puts("   Elements added with push_back\n");
+    LOG("   Elements added with push_back\n");
     
-    uart::puts("   List size: ");
-    uart::print_number(list.size());
-    uart::puts("\n");
+    LOG("   List size: %u\n", list.size());
     
-    uart::puts("   Testing front and back access:\n");
-    uart::puts("   Front: ");
-    uart::print_number(list.front());
-    uart::puts(", Back: ");
-    uart::print_number(list.back());
-    uart::puts("\n");
+    LOG("   Testing front and back access:\n");
+    LOG("   Front: %d, Back: %d\n", list.front(), list.back());
     
-    uart::puts("   Testing push_front...\n");
+    LOG("   Testing push_front...\n");
     list.push_front(5);
-    uart::puts("   Element added with push_front\n");
+    LOG("   Element added with push_front\n");
     
-    uart::puts("   New front: ");
-    uart::print_number(list.front());
-    uart::puts("\n");
+    LOG("   New front: %d\n", list.front());
     
-    uart::puts("   Testing emplace_back...\n");
+    LOG("   Testing emplace_back...\n");
     list.emplace_back(40);
-    uart::puts("   Element emplaced at back\n");
+    LOG("   Element emplaced at back\n");
     
-    uart::puts("   New back: ");
-    uart::print_number(list.back());
-    uart::puts("\n");
+    LOG("   New back: %d\n", list.back());
     
-    uart::puts("   Testing emplace_front...\n");
+    LOG("   Testing emplace_front...\n");
     list.emplace_front(1);
-    uart::puts("   Element emplaced at front\n");
+    LOG("   Element emplaced at front\n");
     
-    uart::puts("   New front: ");
-    uart::print_number(list.front());
-    uart::puts("\n");
+    LOG("   New front: %d\n", list.front());
     
-    uart::puts("   Final list size: ");
-    uart::print_number(list.size());
-    uart::puts("\n");
+    LOG("   Final list size: %u\n", list.size());
     
-    uart::puts("   Testing iterator - List contents: ");
+    LOG("   Testing iterator - List contents: ");
     for (auto it = list.begin(); it != list.end(); ++it) {
-        uart::print_number(*it);
-        uart::puts(" ");
+        LOG("%d ", *it);
     }
-    uart::puts("\n");
+    LOG("\n");
     
-    uart::puts("   Testing pop operations...\n");
+    LOG("   Testing pop operations...\n");
     list.pop_front();
     list.pop_back();
-    uart::puts("   Popped front and back\n");
+    LOG("   Popped front and back\n");
     
-    uart::puts("   Size after pops: ");
-    uart::print_number(list.size());
-    uart::puts("\n");
+    LOG("   Size after pops: %u\n", list.size());
     
-    uart::puts("   List test completed successfully\n");
+    LOG("   List test completed successfully\n");
+}
+
+static inline uint32_t read_mcycle() {
+    return csr<CSR_MCYCLE>::read();
+}
+
+void test_uart_driver() {
+    PROFILE_SCOPE("test_uart_driver");
+    LOG("=== Testing UART Driver ===\n");
+    
+    static const char line[] = "   The quick brown fox jumps over the lazy dog 0123456789\n";
+    const size_t len = sizeof(line) - 1;
+    
+    // Start both measurements from an idle transmitter, with no log
+    // output left to drain into it
+    BinLog::flush();
+    uint32_t start = read_mcycle();
+    UartDriver::write_polled(line, len);
+    uint32_t polled_cycles = read_mcycle() - start;
+    
+    UartDriver::flush();
+    start = read_mcycle();
+    size_t queued = UartDriver::write(line, len);
+    uint32_t buffered_cycles = read_mcycle() - start;
+    UartDriver::flush();
+    
+    LOG("   Polled write cycles: %u\n", polled_cycles);
+    LOG("   Buffered write cycles: %u (%u bytes queued)\n", buffered_cycles, queued);
+    
+    char input[16];
+    size_t received = UartDriver::read(input, sizeof(input));
+    LOG("   Bytes waiting in RX ring: %u\n", received);
+    
+    const UartStats& stats = UartDriver::get_stats();
+    LOG("   TX bytes: %u, TX interrupts: %u, TX stalls: %u\n", stats.tx_bytes, stats.tx_interrupts,
+        stats.tx_stalls);
+    LOG("   RX bytes: %u, RX overruns: %u\n", stats.rx_bytes, stats.rx_overruns);
+}
+
+static volatile uint32_t timer_fired_mask = 0;
+
+static void on_timer(void* context) {
+    timer_fired_mask |= (uint32_t)(uintptr_t)context;
+}
+
+void test_timers() {
+    PROFILE_SCOPE("test_timers");
+    LOG("=== Testing Timers ===\n");
+    
+    const TimerStats& stats = ClintTimer::get_stats();
+    uint32_t interrupts_before = stats.interrupts;
+    uint64_t start = ClintTimer::now();
+    
+    LOG("   Scheduling timers at 5ms, 1ms, 2ms and 3ms (3ms cancelled)...\n");
+    ClintTimer::schedule_after(ClintTimer::ms_to_ticks(5), on_timer, (void*)4);
+    ClintTimer::schedule_after(ClintTimer::ms_to_ticks(1), on_timer, (void*)1);
+    ClintTimer::schedule_at(start + ClintTimer::ms_to_ticks(2), on_timer, (void*)2);
+    TimerId cancelled = ClintTimer::schedule_after(ClintTimer::ms_to_ticks(3), on_timer, (void*)8);
+    ClintTimer::cancel(cancelled);
+    
+    LOG("   Pending timers: %u\n", ClintTimer::pending());
+    
+    // Idle in wfi; masking around the check means a timer that fires just
+    // before wfi still wakes it (the interrupt is pending, not lost)
+    while (timer_fired_mask != 7) {
+        InterruptGuard guard;
+        if (timer_fired_mask != 7) {
+            asm volatile ("wfi");
+        }
+    }
+    
+    uint64_t elapsed = ClintTimer::now() - start;
+    LOG("   All timers fired after %u us, cancelled timer fired: %s\n",
+        (uint32_t)(elapsed / ClintTimer::us_to_ticks(1)), (timer_fired_mask & 8) ? "yes" : "no");
+    LOG("   Timer interrupts taken: %u (tickless: one per distinct deadline)\n",
+        stats.interrupts - interrupts_before);
+}
+
+static volatile bool printer_done = false;
+static volatile uint32_t compute_chunks = 0;
+static uint32_t ticker_wakeups_us[3];
+static TaskEvent ping;
+static TaskEvent pong;
+static uint32_t round_trips = 0;
+
+// CPU-bound work in small chunks, yielding between them
+static void compute_task(void*) {
+    while (!printer_done) {
+        volatile uint32_t accumulator = 0;
+        for (uint32_t i = 0; i < 2000; i++) {
+            accumulator += i * i;
+        }
+        compute_chunks++;
+        Scheduler::yield();
+    }
+}
+
+// More output than the TX ring holds: this task blocks on ring space and
+// the compute task runs while the UART drains
+static void printer_task(void*) {
+    for (uint32_t line = 0; line < 16; line++) {
+        uart::puts("   printer: ........................................ line ");
+        uart::print_number(line);
+        uart::puts("\n");
+    }
+    printer_done = true;
+}
+
+static void ticker_task(void*) {
+    uint64_t start = ClintTimer::now();
+    for (uint32_t i = 0; i < 3; i++) {
+        Scheduler::sleep_ms(1);
+        ticker_wakeups_us[i] = (uint32_t)((ClintTimer::now() - start) / ClintTimer::us_to_ticks(1));
+    }
+}
+
+static void ping_task(void*) {
+    for (uint32_t i = 0; i < 5; i++) {
+        ping.signal();
+        pong.wait();
+        round_trips++;
+    }
+}
+
+static void pong_task(void*) {
+    for (uint32_t i = 0; i < 5; i++) {
+        ping.wait();
+        pong.signal();
+    }
+}
+
+void test_scheduler() {
+    PROFILE_SCOPE("test_scheduler");
+    LOG("=== Testing Cooperative Scheduler ===\n");
+    
+    // The printer task writes to the UART directly
+    BinLog::flush();
+    uint32_t stalls_before = UartDriver::get_stats().tx_stalls;
+    
+    Task* created[5];
+    created[0] = Scheduler::create("compute", compute_task, nullptr);
+    created[1] = Scheduler::create("printer", printer_task, nullptr);
+    created[2] = Scheduler::create("ticker", ticker_task, nullptr);
+    created[3] = Scheduler::create("ping", ping_task, nullptr, 2048);
+    created[4] = Scheduler::create("pong", pong_task, nullptr, 2048);
+    for (Task* task : created) {
+        if (!task) {
+            LOG("   Task creation failed\n");
+            return;
+        }
+    }
+    
+    for (Task* task : created) {
+        Scheduler::join(task);
+    }
+    
+    LOG("   Compute chunks run while printing: %u\n", compute_chunks);
+    LOG("   Printer blocked on TX ring space: %u times\n",
+        UartDriver::get_stats().tx_stalls - stalls_before);
+    LOG("   Ticker woke after (us):");
+    for (uint32_t us : ticker_wakeups_us) {
+        LOG(" %u", us);
+    }
+    LOG("\n");
+    LOG("   Ping/pong round trips: %u\n", round_trips);
+    
+    for (uint32_t i = 0; i < Scheduler::task_count(); i++) {
+        Task* task = Scheduler::get_task(i);
+        LOG("   Task %s: switches=%u stack used=%u/%u\n", task->name, task->switches,
+            Scheduler::stack_usage(task), task->stack_size);
+    }
+}
+
+static volatile bool busy_stop = false;
+static volatile uint32_t busy_spins[2];
+static uint32_t control_late_max_us = 0;
+
+// Never yields: only a time slice or a higher-priority wakeup takes the
+// CPU away from it
+static void busy_task(void* arg) {
+    volatile uint32_t* spins = (volatile uint32_t*)arg;
+    while (!busy_stop) {
+        (*spins)++;
+    }
+}
+
+// Periodic high-priority work; how late each wakeup runs is the
+// scheduling latency the busy tasks impose on it
+static void control_task(void*) {
+    for (uint32_t i = 0; i < 20; i++) {
+        uint64_t deadline = ClintTimer::now() + ClintTimer::us_to_ticks(500);
+        Scheduler::sleep(ClintTimer::us_to_ticks(500));
+        uint32_t late_us = (uint32_t)((ClintTimer::now() - deadline) / ClintTimer::us_to_ticks(1));
+        if (late_us > control_late_max_us) control_late_max_us = late_us;
+    }
+}
+
+void test_preemption() {
+    PROFILE_SCOPE("test_preemption");
+    LOG("=== Testing Preemptive Scheduler ===\n");
+    
+    BinLog::flush();
+    SchedulerStats before = Scheduler::get_stats();
+    Scheduler::enable_preemption(ClintTimer::us_to_ticks(1000));
+    
+    Task* control = Scheduler::create("control", control_task, nullptr, 2048, 12);
+    Task* busy_a = Scheduler::create("busy_a", busy_task, (void*)&busy_spins[0], 2048, 4);
+    Task* busy_b = Scheduler::create("busy_b", busy_task, (void*)&busy_spins[1], 2048, 4);
+    if (!control || !busy_a || !busy_b) {
+        LOG("   Task creation failed\n");
+        Scheduler::disable_preemption();
+        return;
+    }
+    
+    // main (priority 8) blocks here; the busy tasks share the CPU by time
+    // slice and the control task preempts them on every wakeup
+    Scheduler::join(control);
+    busy_stop = true;
+    Scheduler::join(busy_a);
+    Scheduler::join(busy_b);
+    Scheduler::disable_preemption();
+    Scheduler::update_cpu_usage();
+    
+    const SchedulerStats& stats = Scheduler::get_stats();
+    LOG("   Busy spins a/b: %u/%u\n", busy_spins[0], busy_spins[1]);
+    LOG("   Control wakeups late by at most %u us\n", control_late_max_us);
+    LOG("   Preemptions: %u (slice expiries: %u, switch requests: %u)\n",
+        stats.preemptions - before.preemptions, stats.slice_expiries - before.slice_expiries,
+        stats.switch_requests - before.switch_requests);
+    LOG("   Worst scheduling latency: %u cycles\n", stats.latency_max);
+    
+    uint64_t elapsed = Scheduler::get_task(0)->run_started - stats.start_cycles;
+    LOG("   Idle: %u%%\n", (uint32_t)(stats.idle_cycles * 100 / elapsed));
+    for (uint32_t i = 0; i < Scheduler::task_count(); i++) {
+        Task* task = Scheduler::get_task(i);
+        LOG("   Task %s: priority=%u cpu=%u%% wakeups=%u latency max=%u preempted=%u\n", task->name,
+            task->priority, (uint32_t)(task->run_cycles * 100 / elapsed), task->wakeups,
+            task->latency_max, task->preemptions);
+    }
+}
+
+static constexpr uint32_t SMP_JOBS = 64;
+static constexpr uint32_t SMP_JOB_WORDS = 64;
+static uint32_t smp_data[SMP_JOBS * SMP_JOB_WORDS];
+static uint32_t smp_jobs_done = 0;
+static TicketLock smp_ticket_lock;
+static SpinLock smp_spin_lock;
+static uint32_t smp_ticket_count = 0;
+static uint32_t smp_spin_count = 0;
+
+// CPU-bound slice of work; the shared counters are plain variables, so
+// any hole in the locks shows up as a lost update
+static void smp_job(void* arg) {
+    uint32_t* words = smp_data + (uintptr_t)arg * SMP_JOB_WORDS;
+    for (uint32_t i = 0; i < SMP_JOB_WORDS; i++) {
+        uint32_t x = words[i] | 1;
+        for (uint32_t round = 0; round < 200; round++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+        }
+        words[i] = x;
+    }
+    {
+        LockGuard<TicketLock> lock(smp_ticket_lock);
+        smp_ticket_count++;
+    }
+    {
+        LockGuard<SpinLock> lock(smp_spin_lock);
+        smp_spin_count++;
+    }
+    __atomic_fetch_add(&smp_jobs_done, 1u, __ATOMIC_RELEASE);
+}
+
+static uint32_t smp_checksum() {
+    uint32_t sum = 0;
+    for (uint32_t word : smp_data) {
+        sum = sum * 31 + word;
+    }
+    return sum;
+}
+
+static void smp_reset_data() {
+    for (uint32_t i = 0; i < SMP_JOBS * SMP_JOB_WORDS; i++) {
+        smp_data[i] = i * 2654435761u;
+    }
+}
+
+void test_smp() {
+    PROFILE_SCOPE("test_smp");
+    LOG("=== Testing SMP Work Stealing ===\n");
+    LOG("   Harts online: %u\n", Smp::hart_count());
+    
+    // Reference run on hart 0 alone (mtime: wall time, comparable across harts)
+    smp_reset_data();
+    uint64_t start = ClintTimer::now();
+    for (uint32_t job = 0; job < SMP_JOBS; job++) {
+        smp_job((void*)(uintptr_t)job);
+    }
+    uint64_t serial_ticks = ClintTimer::now() - start;
+    uint32_t expected = smp_checksum();
+    
+    // Same jobs queued on hart 0; the others steal them while hart 0 helps
+    smp_reset_data();
+    smp_jobs_done = 0;
+    smp_ticket_count = 0;
+    smp_spin_count = 0;
+    Smp::reset_stats();
+    start = ClintTimer::now();
+    for (uint32_t job = 0; job < SMP_JOBS; job++) {
+        if (!Smp::submit(SmpJob{smp_job, (void*)(uintptr_t)job})) {
+            smp_job((void*)(uintptr_t)job);
+        }
+    }
+    while (__atomic_load_n(&smp_jobs_done, __ATOMIC_ACQUIRE) < SMP_JOBS) {
+        if (!Smp::run_one()) cpu_relax();
+    }
+    uint64_t parallel_ticks = ClintTimer::now() - start;
+    
+    LOG("   Serial/parallel us: %u/%u speedup x100: %u\n",
+        (uint32_t)(serial_ticks / ClintTimer::us_to_ticks(1)),
+        (uint32_t)(parallel_ticks / ClintTimer::us_to_ticks(1)),
+        parallel_ticks ? (uint32_t)(serial_ticks * 100 / parallel_ticks) : 0);
+    LOG("   Results match serial run: %s\n", smp_checksum() == expected ? "yes" : "no");
+    LOG("   Locked counters ticket/spin: %u/%u (expected %u)\n", smp_ticket_count, smp_spin_count,
+        SMP_JOBS);
+    for (uint32_t hart = 0; hart < Smp::hart_count(); hart++) {
+        const HartStats& stats = Smp::get_stats(hart);
+        LOG("   Hart %u: jobs=%u stolen=%u/%u ipis sent=%u wakeups=%u\n", hart, stats.jobs_run,
+            stats.jobs_stolen, stats.steal_attempts, stats.ipis_sent, stats.wakeups);
+    }
+}
+
+void test_parallel_for() {
+    PROFILE_SCOPE("test_parallel_for");
+    LOG("=== Testing parallel_for ===\n");
+    
+    const size_t count = 32768;
+    int* input = new int[count];
+    for (size_t i = 0; i < count; i++) {
+        input[i] = (int)i - 1000;
+    }
+    DataProcessor processor(count);
+    
+    // Same call at every hart count; the first run is the reference
+    uint32_t reference_us = 0;
+    bool correct = true;
+    for (uint32_t harts = 1; harts <= Smp::hart_count(); harts++) {
+        set_parallel_concurrency(harts);
+        uint64_t start = ClintTimer::now();
+        processor.process_array_data(input, count);
+        uint32_t us = (uint32_t)((ClintTimer::now() - start) / ClintTimer::us_to_ticks(1));
+        if (harts == 1) reference_us = us;
+        
+        const int* output = processor.get_processed_data();
+        for (size_t i = 0; i < count; i++) {
+            if (output[i] != input[i] * 2 + 1) correct = false;
+        }
+        LOG("   process_array_data x%u on %u hart(s): %u us, speedup x100: %u\n", count, harts, us,
+            us ? reference_us * 100 / us : 0);
+    }
+    set_parallel_concurrency(0);
+    delete[] input;
+    
+    // TaskGroup: independent jobs, waited for together
+    static uint32_t sums[4];
+    TaskGroup group;
+    for (uint32_t i = 0; i < 4; i++) {
+        group.run([](void* arg) {
+            uint32_t* sum = (uint32_t*)arg;
+            uint32_t index = (uint32_t)(sum - sums);
+            *sum = 0;
+            for (uint32_t value = 0; value <= 1000 * (index + 1); value++) {
+                *sum += value;
+            }
+        }, &sums[i]);
+    }
+    group.wait();
+    for (uint32_t i = 0; i < 4; i++) {
+        uint32_t n = 1000 * (i + 1);
+        if (sums[i] != n * (n + 1) / 2) correct = false;
+    }
+    LOG("   Results correct: %s\n", correct ? "yes" : "no");
+}
+
+void test_vector_kernels() {
+    PROFILE_SCOPE("test_vector_kernels");
+    LOG("=== Testing Vector Kernels ===\n");
+    LOG("   RVV path: %s\n",
+        VectorKernels::vector_enabled() ? "enabled" : (VECTOR_KERNELS_RVV ? "no V on this hart" : "not built"));
+    
+    // Odd length so the final strip is partial
+    const size_t count = 1001;
+    static int32_t source[count];
+    static int32_t vector_out[count];
+    static int32_t scalar_out[count];
+    for (size_t i = 0; i < count; i++) {
+        source[i] = (int32_t)(i * 7919) - 500000;
+    }
+    
+    uint32_t start = csr<CSR_MCYCLE>::read();
+    VectorKernels::map_affine_scalar(scalar_out, source, count, 2, 1);
+    uint32_t scalar_cycles = csr<CSR_MCYCLE>::read() - start;
+    start = csr<CSR_MCYCLE>::read();
+    VectorKernels::map_affine(vector_out, source, count, 2, 1);
+    uint32_t vector_cycles = csr<CSR_MCYCLE>::read() - start;
+    
+    bool match = VectorKernels::sum(source, count) == VectorKernels::sum_scalar(source, count);
+    for (size_t i = 0; i < count; i++) {
+        if (vector_out[i] != scalar_out[i]) match = false;
+    }
+    VectorKernels::fill(vector_out, count, 7);
+    for (size_t i = 0; i < count; i++) {
+        if (vector_out[i] != 7) match = false;
+    }
+    
+    LOG("   map_affine x%u cycles scalar/dispatched: %u/%u\n", count, scalar_cycles, vector_cycles);
+    LOG("   Results match scalar: %s\n", match ? "yes" : "no");
+}
+
+void test_trap_latency() {
+    PROFILE_SCOPE("test_trap_latency");
+    LOG("=== Trap Latency ===\n");
+    
+    TrapLatency latency;
+    InterruptController::measure_trap_latency(64, latency);
+    
+    LOG("   Frame bytes: %u\n", latency.frame_bytes);
+    LOG("   Entry cycles min/avg: %u/%u\n", latency.entry_min, latency.entry_avg);
+    LOG("   Exit cycles min/avg: %u/%u\n", latency.exit_min, latency.exit_avg);
+}
+
+void print_interrupt_events() {
+    LOG("=== Interrupt Events ===\n");
+    
+    InterruptEvent events[8];
+    uint32_t total = 0;
+    uint32_t count;
+    while ((count = InterruptController::drain_events(events, 8)) > 0) {
+        for (uint32_t i = 0; i < count; i++) {
+            LOG("   cause=%u source=%u cycle=%u\n", events[i].cause, events[i].source,
+                events[i].timestamp);
+        }
+        total += count;
+    }
+    
+    const InterruptStats& stats = InterruptController::get_stats();
+    for (uint32_t source = 1; source < PLIC_MAX_SOURCES; source++) {
+        const ExternalSourceStats& per_source = stats.external_sources[source];
+        if (!per_source.count) continue;
+        LOG("   PLIC source %u: count=%u latency avg/max=%u/%u service max=%u\n", source,
+            per_source.count, per_source.latency_total / per_source.count, per_source.latency_max,
+            per_source.service_max);
+    }
+    LOG("   Most claims drained in one trap: %u\n", stats.max_claims_per_trap);
+    
+    LOG("   Events drained: %u, dropped: %u\n", total, stats.dropped_event_count);
+}
+
+void print_slab_statistics() {
+    LOG("=== Slab Allocator Statistics ===\n");
+    LOG("   size  slabs  capacity  in_use  peak\n");
+    for (uint32_t i = 0; i < SlabAllocator::CLASS_COUNT; i++) {
+        SlabAllocator::ClassStats stats = SlabAllocator::get_class_stats(i);
+        if (stats.slab_count == 0) continue;
+        LOG("   %u  %u  %u  %u  %u\n", stats.object_size, stats.slab_count, stats.capacity,
+            stats.in_use, stats.peak_in_use);
+    }
+}
+
+void print_log_statistics() {
+    BinLogStats stats = BinLog::get_stats();
+    LOG("=== Binary Log ===\n");
+    LOG("   Call sites: %u, records written: %u, dropped: %u, drained so far: %u\n",
+        BinLog::site_count(), stats.written, stats.dropped, stats.drained);
+}
+
+void test_queue_functions() {
+    PROFILE_SCOPE("test_queue_functions");
+    LOG("=== Testing Queue Functions ===\n");
+    
+    LOG("1. Testing RingDeque (FIFO work queue):\n");
+    RingDeque<int> queue;
+    for (int i = 1; i <= 10; i++) {
+        queue.push_back(i * 10);
+    }
+    queue.push_front(5);
+    
+    LOG("   Queue size: %u, capacity: %u\n", queue.size(), queue.capacity());
+    
+    LOG("   Draining three from the front: ");
+    for (int i = 0; i < 3; i++) {
+        LOG("%d ", queue.front());
+        queue.pop_front();
+    }
+    LOG("\n");
+    
+    LOG("   Refilling past the wrap point...\n");
+    for (int i = 11; i <= 13; i++) {
+        queue.push_back(i * 10);
+    }
+    
+    LOG("   Queue contents: ");
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        LOG("%d ", *it);
+    }
+    LOG("\n");
+    
+    LOG("2. Testing SmallVector (inline storage):\n");
+    SmallVector<int, 4> vec;
+    for (int i = 1; i <= 4; i++) {
+        vec.push_back(i);
+    }
+    LOG("   4 elements, inline: %s\n", vec.is_small() ? "yes" : "no");
+    
+    vec.push_back(5);
+    LOG("   5 elements, inline: %s, capacity: %u\n", vec.is_small() ? "yes" : "no", vec.capacity());
+    
+    LOG("   Vector contents: ");
+    for (auto it = vec.begin(); it != vec.end(); ++it) {
+        LOG("%d ", *it);
+    }
+    LOG("\n");
+    
+    LOG("   Queue test completed successfully\n");
+}
+
+// Element type that counts how it is constructed
+struct TrackedValue {
+    static uint32_t copies;
+    static uint32_t moves;
+    int value;
+    
+    TrackedValue() : value(0) {}
+    explicit TrackedValue(int v) : value(v) {}
+    TrackedValue(int a, int b) : value(a + b) {}
+    TrackedValue(const TrackedValue& other) : value(other.value) { copies++; }
+    TrackedValue(TrackedValue&& other) : value(other.value) { moves++; }
+    TrackedValue& operator=(const TrackedValue& other) { value = other.value; copies++; return *this; }
+    TrackedValue& operator=(TrackedValue&& other) { value = other.value; moves++; return *this; }
+    
+    static void reset() { copies = 0; moves = 0; }
+};
+
+uint32_t TrackedValue::copies = 0;
+uint32_t TrackedValue::moves = 0;
+
+// Node allocator that counts allocations on top of the slab allocator
+struct CountingNodeAllocator {
+    static uint32_t allocations;
+    static void* allocate(size_t size) { allocations++; return SlabAllocator::allocate(size); }
+    static void deallocate(void* ptr, size_t size) { SlabAllocator::deallocate(ptr, size); }
+};
+
+uint32_t CountingNodeAllocator::allocations = 0;
+
+typedef SimpleList<TrackedValue, CountingNodeAllocator> TrackedList;
+typedef SimpleMap<int, TrackedValue, CountingNodeAllocator> TrackedMap;
+
+TrackedList make_tracked_list(int count) {
+    TrackedList list;
+    for (int i = 0; i < count; i++) {
+        list.emplace_back(i);
+    }
+    return list;
+}
+
+static void expect_counts(const char* what, uint32_t copies, uint32_t moves, uint32_t allocations) {
+    bool ok = TrackedValue::copies == copies && TrackedValue::moves == moves &&
+              CountingNodeAllocator::allocations == allocations;
+    LOG("   %s: copies=%u moves=%u allocations=%u (%s)\n", what, TrackedValue::copies,
+        TrackedValue::moves, CountingNodeAllocator::allocations, ok ? "as expected" : "UNEXPECTED");
+    TrackedValue::reset();
+    CountingNodeAllocator::allocations = 0;
+}
+
+void test_move_semantics() {
+    PROFILE_SCOPE("test_move_semantics");
+    LOG("=== Testing Move Semantics ===\n");
+    TrackedValue::reset();
+    CountingNodeAllocator::allocations = 0;
+    
+    LOG("1. SimpleList:\n");
+    TrackedList list;
+    list.emplace_back(1);
+    list.emplace_front(2, 3);
+    expect_counts("emplace_back/emplace_front", 0, 0, 2);
+    
+    list.push_back(TrackedValue(4));
+    expect_counts("push_back(T&&)", 0, 1, 1);
+    
+    TrackedValue lvalue(5);
+    list.push_front(lvalue);
+    expect_counts("push_front(const T&)", 1, 0, 1);
+    
+    TrackedList moved(std::move(list));
+    expect_counts("move construct", 0, 0, 0);
+    
+    list = std::move(moved);
+    expect_counts("move assign", 0, 0, 0);
+    
+    TrackedList returned = make_tracked_list(8);
+    expect_counts("return by value", 0, 0, 8);
+    
+    LOG("2. SimpleMap:\n");
+    TrackedMap map;
+    map.emplace_back(1, 10, 1);
+    expect_counts("emplace_back new key", 0, 0, 1);
+    
+    map.insert(2, TrackedValue(20));
+    expect_counts("insert(Value&&)", 0, 1, 1);
+    
+    map[3].value = 30;
+    expect_counts("operator[] new key", 0, 0, 1);
+    
+    TrackedMap moved_map(std::move(map));
+    expect_counts("move construct", 0, 0, 0);
+    
+    LOG("   Move semantics test completed\n");
 }
 
 void test_math_functions() {
-    uart::puts("=== Testing Math Functions ===\n");
+    PROFILE_SCOPE("test_math_functions");
+    LOG("=== Testing Math Functions ===\n");
     
     // Test basic math functions
-    uart::puts("1. Testing basic math:\n");
-    uart::puts("   abs(-42) = ");
-    uart::print_number(abs(-42));
-    uart::puts("\n");
+    LOG("1. Testing basic math:\n");
+    LOG("   abs(-42) = %d\n", abs(-42));
     
-    uart::puts("   sqrt(16) = ");
-    uart::print_number((int)sqrt(16.0));
-    uart::puts("\n");
+    LOG("   sqrt(16) = %d\n", (int)sqrt(16.0));
     
-    uart::puts("   pow(2, 3) = ");
-    uart::print_number((int)pow(2.0, 3.0));
-    uart::puts("\n");
+    LOG("   pow(2, 3) = %d\n", (int)pow(2.0, 3.0));
     
     // Test random numbers
-    uart::puts("2. Testing random numbers:\n");
+    LOG("2. Testing random numbers:\n");
     srand(42);  // Seed for reproducible results
-    uart::puts("   Random numbers: ");
+    LOG("   Random numbers: ");
     for (int i = 0; i < 5; i++) {
-        uart::print_number(rand() % 100);
-        uart::puts(" ");
+        LOG("%d ", rand() % 100);
     }
-    uart::puts("\n");
+    LOG("\n");
 }
 
 extern "C" int main() {
     uart::puts("RISC-V C++ Program with Standard Library\n");
     uart::puts("========================================\n\n");
 
+    LOG("Boot: %u cycles from _start to main (%u copying sections and clearing BSS)\n",
+        boot_timing.to_main_cycles, boot_timing.section_init_cycles);
     SimpleAllocator::init();
     InterruptController::init();
+    Plic::init();
+    UartDriver::init();
+    ClintTimer::init();
+    Profiler::init();
+    Scheduler::init();
+    BinLog::init();
+    Smp::init();
+    VectorKernels::init();
     InterruptController::enable_global_interrupts();
 
     test_stdlib_functions();
-    uart::puts("\n");
+    LOG("\n");
     test_class_functions();
-    uart::puts("\n");
+    LOG("\n");
     test_map_functions();
-    uart::puts("\n");
+    LOG("\n");
+    test_hash_map_functions();
+    LOG("\n");
+    test_flat_map_functions();
+    LOG("\n");
     test_list_functions();
+    LOG("\n");
+    test_queue_functions();
+    LOG("\n");
+    test_move_semantics();
+    LOG("\n");
+    print_slab_statistics();
+    LOG("\n");
+    test_uart_driver();
+    LOG("\n");
+    test_trap_latency();
+    LOG("\n");
+    test_timers();
+    LOG("\n");
+    test_scheduler();
+    LOG("\n");
+    test_preemption();
+    LOG("\n");
+    test_smp();
+    LOG("\n");
+    test_parallel_for();
+    LOG("\n");
+    test_vector_kernels();
+    LOG("\n");
+    print_interrupt_events();
+    LOG("\n");
+    print_log_statistics();
+    LOG("\n");
+    
+    // The profile report writes to the UART directly
+    BinLog::flush();
+    Profiler::report();
     
     uart::puts("\n=== All tests completed! ===\n");
+    UartDriver::flush();
     return 0;
 }
@@ -1,5 +1,6 @@
 #include "memory.h"
-#include "uart.h"
+#include "binlog.h"
+#include "placement.h"
 
 // External symbols from linker script
 extern "C" {
@@ -8,75 +9,66 @@ extern "C" {
 }
 
 // Static member definitions
-uint8_t* SimpleAllocator::heap_start = nullptr;
-uint8_t* SimpleAllocator::heap_end = nullptr;
-uint8_t* SimpleAllocator::heap_current = nullptr;
+FAST_RAM TlsfHeap SimpleAllocator::heap;
 
 void SimpleAllocator::init() {
-    heap_start = &__heap_start;
-    heap_end = &__heap_end;
-    heap_current = heap_start;
+    uint8_t* heap_start = &__heap_start;
+    uint8_t* heap_end = &__heap_end;
+    heap.init(heap_start, heap_end - heap_start);
     
-    uart::puts("heap_start :: ");
-    uart::print_number((uint32_t)heap_start);
-    uart::puts("\n");
-    uart::puts("heap_end :: ");
-    uart::print_number((uint32_t)heap_end);
-    uart::puts("\n");
-    uart::puts("heap_current :: ");
-    uart::print_number((uint32_t)heap_current);
-    uart::puts("\n");
+    // Logged, not printed: this runs first thing in main, before the UART
+    // driver, and three blocking lines would hold up the rest of bring-up
+    LOG("heap_start :: %u\n", (uint32_t)heap_start);
+    LOG("heap_end :: %u\n", (uint32_t)heap_end);
+    LOG("heap_free :: %u\n", (uint32_t)heap.get_free_memory());
 }
 
-void* SimpleAllocator::allocate(size_t size) {
-    // Align to 8-byte boundary
-    size = (size + 7) & ~7;
-    
-    // Simple bump allocator - no headers, no complexity
-    if (heap_current + size > heap_end) {
-        return nullptr; // Out of memory
-    }
-    
-    void* ptr = heap_current;
-    heap_current += size;
-    
-    return ptr;
+HOT_CODE void* SimpleAllocator::allocate(size_t size) {
+    return heap.allocate(size);
 }
 
-void SimpleAllocator::deallocate(void* ptr) {
-    // Simple bump allocator - no deallocation
-    // This is acceptable for testing std::map
-    (void)ptr;
+HOT_CODE void SimpleAllocator::deallocate(void* ptr) {
+    heap.deallocate(ptr);
+}
+
+HOT_CODE void SimpleAllocator::deallocate(void* ptr, size_t size) {
+    heap.deallocate(ptr, size);
 }
 
 size_t SimpleAllocator::get_free_memory() {
-    return heap_end - heap_current;
+    return heap.get_free_memory();
+}
+
+size_t SimpleAllocator::get_largest_free_block() {
+    return heap.get_largest_free_block();
+}
+
+const TlsfHeap::Stats& SimpleAllocator::get_stats() {
+    return heap.get_stats();
 }
 
 // Global new/delete operators
-void* operator new(size_t size) {
+HOT_CODE void* operator new(size_t size) {
     return SimpleAllocator::allocate(size);
 }
 
-void* operator new[](size_t size) {
+HOT_CODE void* operator new[](size_t size) {
     return SimpleAllocator::allocate(size);
 }
 
-void operator delete(void* ptr) noexcept {
+HOT_CODE void operator delete(void* ptr) noexcept {
     SimpleAllocator::deallocate(ptr);
 }
 
-void operator delete[](void* ptr) noexcept {
+HOT_CODE void operator delete[](void* ptr) noexcept {
     SimpleAllocator::deallocate(ptr);
 }
 
-void operator delete(void* ptr, size_t size) noexcept {
-    (void)size;
-    SimpleAllocator::deallocate(ptr);
+HOT_CODE void operator delete(void* ptr, size_t size) noexcept {
+    SimpleAllocator::deallocate(ptr, size);
 }
 
-void operator delete[](void* ptr, size_t size) noexcept {
-    (void)size;
-    SimpleAllocator::deallocate(ptr);
+HOT_CODE void operator delete[](void* ptr, size_t size) noexcept {
+    SimpleAllocator::deallocate(ptr, size);
 }
 
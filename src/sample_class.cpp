@@ -1,5 +1,8 @@
 #include "sample_class.h"
 #include "memory.h"
+#include "parallel.h"
+#include "vector_kernels.h"
+#include <cstring>
 
 // Static member definition
 int DataProcessor::instance_count = 0;
@@ -9,9 +12,7 @@ DataProcessor::DataProcessor(size_t initial_size) : array_size(initial_size) {
     dynamic_array = new int[array_size];
     
     // Initialize array with zeros
-    for (size_t i = 0; i < array_size; ++i) {
-        dynamic_array[i] = 0;
-    }
+    memset(dynamic_array, 0, array_size * sizeof(int));
     
     // Increment instance count
     instance_count++;
@@ -27,9 +28,7 @@ DataProcessor::DataProcessor(const DataProcessor& other)
     
     // Deep copy dynamic array
     dynamic_array = new int[array_size];
-    for (size_t i = 0; i < array_size; ++i) {
-        dynamic_array[i] = other.dynamic_array[i];
-    }
+    memcpy(dynamic_array, other.dynamic_array, array_size * sizeof(int));
     
     instance_count++;
 }
@@ -45,9 +44,7 @@ DataProcessor& DataProcessor::operator=(const DataProcessor& other) {
         
         // Deep copy dynamic array
         dynamic_array = new int[array_size];
-        for (size_t i = 0; i < array_size; ++i) {
-            dynamic_array[i] = other.dynamic_array[i];
-        }
+        memcpy(dynamic_array, other.dynamic_array, array_size * sizeof(int));
     }
     return *this;
 }
@@ -60,7 +57,7 @@ int* DataProcessor::get_data(int key) {
     return data_map.find(key);
 }
 
-void DataProcessor::process_array_data(const int* input, size_t input_size) {
+void DataProcessor::process_array_data(const int* input, size_t input_size, size_t grain) {
     // Resize array if needed
     if (input_size > array_size) {
         delete[] dynamic_array;
@@ -68,15 +65,15 @@ void DataProcessor::process_array_data(const int* input, size_t input_size) {
         dynamic_array = new int[array_size];
     }
     
-    // Process data (simple transformation: multiply by 2 and add 1)
-    for (size_t i = 0; i < input_size; ++i) {
-        dynamic_array[i] = input[i] * 2 + 1;
-    }
+    // Process data (simple transformation: multiply by 2 and add 1),
+    // split across the harts; every index is independent
+    int* output = dynamic_array;
+    parallel_for(0, input_size, grain, [input, output](size_t begin, size_t end) {
+        VectorKernels::map_affine(output + begin, input + begin, end - begin, 2, 1);
+    });
     
     // Fill remaining elements with zeros
-    for (size_t i = input_size; i < array_size; ++i) {
-        dynamic_array[i] = 0;
-    }
+    VectorKernels::fill(dynamic_array + input_size, array_size - input_size, 0);
 }
 
 void DataProcessor::demonstrate_map_operations() {